@@ -44,7 +44,9 @@
 // System
 #include <string>
 #include <list>
+#include <vector>
 #include <fstream>
+#include <memory>
 
 // Other
 #include <designators/KeyValuePair.h>
@@ -52,23 +54,21 @@
 // Private
 #include <semrec/Node.h>
 #include <semrec/UtilityBase.h>
+#include <semrec/UniqueIDGenerator.h>
+#include <semrec/DesignatorRegistry.h>
 
 
 namespace semrec {
   class CExporter : public UtilityBase {
   private:
     std::list<Node*> m_lstRootNodes;
-    std::list< std::pair<std::string, std::string> > m_lstDesignatorIDs;
-    std::list< std::pair<std::string, std::string> > m_lstDesignatorEquations;
+    std::shared_ptr<const DesignatorRegistry> m_drDesignators;
   
     KeyValuePair* m_ckvpConfiguration;
-  
-    void renewUniqueIDsForNode(Node *ndRenew);
+    UniqueIDGenerator m_uigIDs;
   
   protected:
-    std::list<Node*> m_lstNodes;
-    
-    std::list< std::pair<std::string, std::string> > m_lstDesignatorEquationTimes;
+    std::vector<Node*> m_vecNodes;
   
   public:
     CExporter();
@@ -77,7 +77,9 @@ namespace semrec {
     KeyValuePair* configuration();
     
     void addNode(Node* ndAdd);
-    std::list<Node*> nodes();
+    /*! \brief Replaces the nodes to export, without deleting the previous ones */
+    void setNodes(const std::list<Node*>& lstNodes);
+    const std::vector<Node*>& nodes();
     void setRootNodes(std::list<Node*> lstRootNodes);
     void addRootNode(Node* ndRoot);
     std::list<Node*> rootNodes();
@@ -98,11 +100,13 @@ namespace semrec {
     virtual bool nodeHasValidDetailLevel(Node* ndDisplay);
     virtual bool nodeDisplayable(Node* ndDisplay);
     
-    void setDesignatorIDs(std::list< std::pair<std::string, std::string> > lstDesignatorIDs);
-    void setDesignatorEquations(std::list< std::pair<std::string, std::string> > lstDesignatorEquations);
-    void setDesignatorEquationTimes(std::list< std::pair<std::string, std::string> > lstDesignatorEquationTimes);  
+    /*! \brief Sets the designators (and their equations) to export
+      
+      The registry is shared, not copied. Passing NULL clears it. */
+    void setDesignatorRegistry(std::shared_ptr<const DesignatorRegistry> drDesignators);
+    const DesignatorRegistry& designatorRegistry();
     
-    std::list<std::string> designatorIDs();
+    const std::vector<std::string>& designatorIDs();
     std::list<std::string> parentDesignatorsForID(std::string strID);
     std::list<std::string> successorDesignatorsForID(std::string strID);
     std::string equationTimeForSuccessorID(std::string strID);
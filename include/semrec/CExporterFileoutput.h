@@ -46,6 +46,7 @@
 
 // Private
 #include <semrec/CExporter.h>
+#include <semrec/OutputSink.h>
 
 
 namespace semrec {
@@ -58,7 +59,7 @@ namespace semrec {
     void setOutputFilename(std::string strFilename);
     std::string outputFilename();
   
-    bool writeToFile(std::string strContent, std::string strFilename = "");
+    bool writeToFile(const std::string& strContent, std::string strFilename = "");
   };
 }
 
@@ -0,0 +1,160 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __DESIGNATOR_REGISTRY_H__
+#define __DESIGNATOR_REGISTRY_H__
+
+
+// System
+#include <string>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <utility>
+#include <algorithm>
+
+
+namespace semrec {
+  /*! \brief Equation of two designators, as logged */
+  typedef struct {
+    std::string strParentID;
+    std::string strChildID;
+    std::string strTime;
+  } DesignatorEquation;
+  
+  /*! \brief Known designators and the equations between them
+    
+    Maps the memory addresses reported by the plan system to unique
+    designator IDs, and keeps the equations as a graph with forward
+    (successor) and reverse (parent) edges. All lookups are hashed;
+    the insertion order of designators and equations is preserved
+    for the exporters.
+    
+    Equated designators are additionally grouped into equivalence
+    classes (union-find, maintained as equations arrive), and the
+    transitive successors of a designator are cached once they were
+    asked for. */
+  class DesignatorRegistry {
+  private:
+    typedef struct {
+      std::string strID;
+      std::string strMemoryAddress;
+      /*! \brief Time this designator was first equated to a parent */
+      std::string strEquationTime;
+      std::vector<unsigned int> vecSuccessors;
+      std::vector<unsigned int> vecParents;
+      /*! \brief Union-find parent; equal to the own index for class representatives */
+      unsigned int unClass;
+      /*! \brief Members of the class, only kept up to date for representatives */
+      std::vector<unsigned int> vecClassMembers;
+    } DesignatorRecord;
+    
+    std::vector<DesignatorRecord> m_vecRecords;
+    std::unordered_map<std::string, unsigned int> m_mapRecordIndices;
+    std::unordered_map<std::string, std::string> m_mapIDsByMemoryAddress;
+    /*! \brief Registered designator IDs, in registration order */
+    std::vector<std::string> m_vecIDs;
+    std::vector<DesignatorEquation> m_vecEquations;
+    
+    /*! \brief Cached transitive successors, by record index */
+    mutable std::unordered_map<unsigned int, std::vector<std::string> > m_mapSuccessorClosures;
+    /*! \brief Per record, the walk that visited it last (see beginWalk) */
+    mutable std::vector<unsigned int> m_vecVisitStamps;
+    mutable unsigned int m_unVisitStamp;
+    /*! \brief Guards the closure cache and the visit stamps */
+    mutable std::mutex m_mtxSuccessorClosures;
+    
+    unsigned int recordIndex(std::string strID);
+    const DesignatorRecord* record(std::string strID) const;
+    unsigned int classOf(unsigned int unRecord) const;
+    void unite(unsigned int unRecordA, unsigned int unRecordB);
+    /*! \brief Starts a graph walk, so that no record counts as visited
+      
+      Must be called with m_mtxSuccessorClosures held. Instead of
+      clearing a visited flag per record, every walk gets a new
+      stamp. */
+    void beginWalk() const;
+    /*! \brief Marks a record as visited in the current walk; returns false if it already was */
+    bool visit(unsigned int unRecord) const;
+    /*! \brief Drops the cached closures that contain the successors of unRecord */
+    void invalidateClosuresReaching(unsigned int unRecord);
+    
+  public:
+    DesignatorRegistry();
+    DesignatorRegistry(const DesignatorRegistry& drCopy);
+    ~DesignatorRegistry();
+    
+    DesignatorRegistry& operator=(const DesignatorRegistry& drCopy);
+    
+    void clear();
+    
+    /*! \brief Registers a designator under the given memory address
+      
+      Does nothing if the memory address is already known. */
+    void registerDesignator(std::string strMemoryAddress, std::string strID);
+    /*! \brief Returns the ID for a memory address, or an empty string if it is unknown */
+    std::string idForMemoryAddress(std::string strMemoryAddress) const;
+    
+    /*! \brief Records that strChildID succeeds (is equated to) strParentID */
+    void addEquation(std::string strParentID, std::string strChildID, std::string strTime);
+    
+    const std::vector<std::string>& designatorIDs() const;
+    const std::vector<DesignatorEquation>& equations() const;
+    
+    std::list<std::string> parentIDs(std::string strID) const;
+    std::list<std::string> successorIDs(std::string strID) const;
+    /*! \brief Returns when strID was first equated to a parent, or an empty string */
+    std::string equationTime(std::string strID) const;
+    
+    /*! \brief Returns all designators reachable from strID via successor edges
+      
+      Deeper successors come before the ones they were equated to,
+      every designator is listed once. The result is computed in
+      time linear in the number of reachable designators and cached
+      afterwards; new equations only drop the cached closures they
+      change. Copies start with an empty cache. */
+    std::vector<std::string> successorClosure(std::string strID) const;
+    /*! \brief Returns all designators equated to strID, directly or indirectly, including strID */
+    std::list<std::string> equivalentIDs(std::string strID) const;
+    /*! \brief Returns whether two designators were equated, directly or indirectly */
+    bool equivalent(std::string strIDA, std::string strIDB) const;
+  };
+}
+
+
+#endif /* __DESIGNATOR_REGISTRY_H__ */
@@ -0,0 +1,87 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __EVENT_ID_H__
+#define __EVENT_ID_H__
+
+
+// System
+#include <string>
+
+
+namespace semrec {
+  /*! \brief Interned identifier for event and service names
+    
+    Identifiers are the 32 bit FNV-1a hash of the respective name. As
+    the hash is constexpr, built-in names can be used as case labels
+    (`case eventID("begin-context"):'), and a hash collision between
+    two built-in names handled in the same switch statement is a
+    compile time error. Names that are only known at runtime are
+    hashed the same way, so external plugins can keep using arbitrary
+    string names. As such a name may share its identifier with
+    another one, switching on the identifier is only safe for events
+    that were routed by name (subscriptions with colliding
+    identifiers are rejected); raw strings from the outside have to
+    be compared by name. */
+  typedef unsigned int EventID;
+  
+  /*! \brief Recursive FNV-1a step, usable in constant expressions */
+  constexpr EventID eventIDStep(const char* cName, EventID eiHash) {
+    return (*cName == '\0' ? eiHash : eventIDStep(cName + 1, (eiHash ^ (EventID)(unsigned char)*cName) * 16777619u));
+  }
+  
+  /*! \brief Compile time identifier for (literal) event and service names */
+  constexpr EventID eventID(const char* cName) {
+    return eventIDStep(cName, 2166136261u);
+  }
+  
+  /*! \brief Runtime identifier for event and service names
+    
+    Yields the same value as the constexpr variant. */
+  inline EventID eventID(const std::string& strName) {
+    EventID eiHash = 2166136261u;
+    
+    for(char cCurrent : strName) {
+      eiHash = (eiHash ^ (EventID)(unsigned char)cCurrent) * 16777619u;
+    }
+    
+    return eiHash;
+  }
+}
+
+
+#endif /* __EVENT_ID_H__ */
@@ -44,9 +44,16 @@
 // System
 #include <ftw.h>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <limits>
+#include <functional>
+#include <memory>
 
 // Private
 #include <semrec/Types.h>
+#include <semrec/MessageSink.h>
 
 
 namespace semrec {
@@ -63,39 +70,58 @@ namespace semrec {
   
   // Event container specific functions
   Event defaultEvent(std::string strEventName = "");
-  Event eventInResponseTo(Event evRequest, std::string strEventName = "");
+  Event eventInResponseTo(const Event& evRequest, std::string strEventName = "");
   
   // Service event container specific functions
   ServiceEvent defaultServiceEvent(std::string strServiceName = "");
-  ServiceEvent eventInResponseTo(ServiceEvent seRequest, std::string strServiceName = "");
+  ServiceEvent eventInResponseTo(const ServiceEvent& seRequest, std::string strServiceName = "");
   
   // Plugin specific functions
   int createPluginID();
   bool pluginIDTaken(int nID);
   void freePluginID(int nID);
+  int createServiceEventID();
   
   // Output specific functions
   std::string colorSpecifierForID(int nID, bool bBold = false);
   std::string normalColorSpecifier();
   
   // Global config settings specific functions
+  /*! \brief Current configuration as an immutable snapshot
+    
+    Loaded atomically without locking or copying the settings; use
+    this on hot paths. Changes made through setConfigSettings() swap
+    in a new snapshot and don't affect snapshots already held. */
+  std::shared_ptr<const ConfigSettings> configSnapshot();
   ConfigSettings configSettings();
   void setConfigSettings(ConfigSettings cfgsetSettings);
   
   // Per-Plugin configuration space accessor function
   Designator* getPluginConfig(std::string strPluginName);
   
+  // Status message output functions
+  MessageSink& messageSink();
   void queueMessage(StatusMessage msgQueue);
   StatusMessage queueMessage(std::string strColorCode, bool bBold, std::string strPrefix, std::string strMessage);
-  std::list<StatusMessage> queuedMessages();
   
-  int nextSequenceNumber();
-  void resetSequenceNumbers();
+  unsigned long nextSequenceNumber();
   
   void revokeGlobalToken(std::string strToken);
   bool waitForGlobalToken(std::string strToken, float fTimeout = 2.0);
   void issueGlobalToken(std::string strToken);
   bool wasGlobalTokenIssued(std::string strToken);
+  
+  // Event name registry functions
+  bool registerEventName(std::string strName);
+  std::string registeredEventName(EventID eiID);
+  
+  // Subscription index invalidation functions
+  void invalidateSubscriptionIndex();
+  unsigned long subscriptionIndexGeneration();
+  
+  // Core loop wakeup functions
+  void notifyCoreWakeup();
+  bool waitForCoreWakeup(float fTimeout);
 }
 
 
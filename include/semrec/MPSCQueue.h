@@ -0,0 +1,128 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __MPSC_QUEUE_H__
+#define __MPSC_QUEUE_H__
+
+
+// System
+#include <atomic>
+#include <list>
+#include <utility>
+
+
+namespace semrec {
+  /*! \brief Lock-free multi-producer/single-consumer queue
+    
+    Any number of threads can push() items concurrently without
+    taking a lock. A single consumer takes all queued items at once
+    through drainInto(), which moves them into a list in the order
+    they were pushed. As the consumer always detaches the whole chain
+    in one atomic exchange, the queue doesn't suffer from the ABA
+    problem. */
+  template<class T>
+  class MPSCQueue {
+  private:
+    typedef struct QueueNode {
+      T tItem;
+      QueueNode* qnNext;
+    } QueueNode;
+    
+    /*! \brief Most recently pushed node; the chain runs backwards in time */
+    std::atomic<QueueNode*> m_qnHead;
+    
+  public:
+    MPSCQueue() : m_qnHead(NULL) {
+    }
+    
+    ~MPSCQueue() {
+      std::list<T> lstDiscard;
+      this->drainInto(lstDiscard);
+    }
+    
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+    
+    void push(T tItem) {
+      QueueNode* qnNew = new QueueNode;
+      qnNew->tItem = std::move(tItem);
+      qnNew->qnNext = m_qnHead.load(std::memory_order_relaxed);
+      
+      while(!m_qnHead.compare_exchange_weak(qnNew->qnNext, qnNew,
+					    std::memory_order_release,
+					    std::memory_order_relaxed)) {
+	// qnNext was updated to the current head; try again.
+      }
+    }
+    
+    /*! \brief Moves all queued items to the end of lstTarget, oldest first
+      
+      Must only be called from one thread at a time. Returns the
+      number of drained items. */
+    int drainInto(std::list<T>& lstTarget) {
+      QueueNode* qnCurrent = m_qnHead.exchange(NULL, std::memory_order_acquire);
+      
+      // Reverse the detached chain to restore push order
+      QueueNode* qnOrdered = NULL;
+      while(qnCurrent) {
+	QueueNode* qnNext = qnCurrent->qnNext;
+	qnCurrent->qnNext = qnOrdered;
+	qnOrdered = qnCurrent;
+	qnCurrent = qnNext;
+      }
+      
+      int nDrained = 0;
+      while(qnOrdered) {
+	QueueNode* qnNext = qnOrdered->qnNext;
+	lstTarget.push_back(std::move(qnOrdered->tItem));
+	delete qnOrdered;
+	
+	qnOrdered = qnNext;
+	nDrained++;
+      }
+      
+      return nDrained;
+    }
+    
+    bool empty() {
+      return m_qnHead.load(std::memory_order_acquire) == NULL;
+    }
+  };
+}
+
+
+#endif /* __MPSC_QUEUE_H__ */
@@ -0,0 +1,157 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __MESSAGE_SINK_H__
+#define __MESSAGE_SINK_H__
+
+
+// System
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Private
+#include <semrec/Types.h>
+
+
+namespace semrec {
+  /*! \brief Receiver for batches of status messages
+    
+    Consumers are called from the sink's writer thread, never from
+    the core cycle (or synchronously from the producing thread while
+    the writer isn't running). They must not block for long, as the
+    ring buffer fills up in the meantime. */
+  class StatusMessageConsumer {
+  public:
+    virtual ~StatusMessageConsumer() {}
+    
+    virtual void consumeStatusMessages(const std::vector<StatusMessage>& vecMessages) = 0;
+  };
+  
+  /*! \brief Bounded, asynchronous output pipeline for status messages
+    
+    Messages are put into a fixed size ring buffer and picked up in
+    batches by a background writer thread, which writes them to the
+    console (one flush per batch) and hands them to all registered
+    consumers. When the ring buffer is full, new messages are either
+    dropped (and counted) or the producer waits for space, depending
+    on the overflow policy. While the writer isn't running, messages
+    are written synchronously by the producing thread. */
+  class MessageSink {
+  public:
+    typedef enum {
+      OP_DROP = 0,
+      OP_BLOCK = 1
+    } OverflowPolicy;
+    
+  private:
+    std::vector<StatusMessage> m_vecRing;
+    size_t m_szHead;
+    size_t m_szCount;
+    OverflowPolicy m_opPolicy;
+    bool m_bRun;
+    bool m_bWriting;
+    std::thread* m_thrdWriter;
+    std::mutex m_mtxRing;
+    std::condition_variable m_cvNotEmpty;
+    std::condition_variable m_cvNotFull;
+    std::condition_variable m_cvDrained;
+    
+    /*! \brief Serializes console writes and consumer deliveries */
+    std::mutex m_mtxOutput;
+    std::list<StatusMessageConsumer*> m_lstConsumers;
+    std::atomic<bool> m_bConsoleOutput;
+    
+    std::atomic<unsigned long> m_ulDroppedMessages;
+    std::atomic<unsigned long> m_ulWrittenMessages;
+    
+    void writerLoop();
+    void writeBatch(const std::vector<StatusMessage>& vecMessages);
+    
+  public:
+    MessageSink(size_t szCapacity = 1024);
+    ~MessageSink();
+    
+    MessageSink(const MessageSink&) = delete;
+    MessageSink& operator=(const MessageSink&) = delete;
+    
+    /*! \brief Starts the background writer thread */
+    void start();
+    /*! \brief Writes all buffered messages and joins the writer thread */
+    void stop();
+    bool running();
+    
+    /*! \brief Resizes the ring buffer
+      
+      Buffered messages are kept in order; if they don't fit
+      anymore, the oldest ones are dropped. */
+    void setCapacity(size_t szCapacity);
+    size_t capacity();
+    
+    void setOverflowPolicy(OverflowPolicy opPolicy);
+    OverflowPolicy overflowPolicy();
+    
+    void setConsoleOutput(bool bConsoleOutput);
+    bool consoleOutput();
+    
+    void addConsumer(StatusMessageConsumer* smcConsumer);
+    /*! \brief Unregisters a consumer
+      
+      Once this returns, the consumer won't be called anymore. */
+    void removeConsumer(StatusMessageConsumer* smcConsumer);
+    
+    /*! \brief Hands a message to the sink
+      
+      Returns false if the message was dropped because the ring
+      buffer was full. */
+    bool push(const StatusMessage& msgStatus);
+    
+    /*! \brief Waits until all messages pushed so far were written */
+    void flush();
+    
+    unsigned long droppedMessages();
+    unsigned long writtenMessages();
+  };
+}
+
+
+#endif /* __MESSAGE_SINK_H__ */
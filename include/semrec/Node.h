@@ -43,6 +43,8 @@
 
 // System
 #include <string>
+#include <list>
+#include <vector>
 
 // Other
 #include <designators/KeyValuePair.h>
@@ -52,12 +54,60 @@ using namespace designator_integration;
 
 
 namespace semrec {
+  class Node;
+  
+  /*! \brief Camera image attached to a node */
+  typedef struct {
+    std::string strOrigin;
+    std::string strFilename;
+    std::string strTimeCapture;
+  } NodeImage;
+  
+  /*! \brief Failure emitted by a node */
+  typedef struct {
+    std::string strCondition;
+    std::string strTimeFail;
+  } NodeFailure;
+  
+  /*! \brief Failure caught by a node, and the node that emitted it */
+  typedef struct {
+    std::string strFailureID;
+    std::string strTimeCatch;
+    Node* ndEmitter;
+  } NodeCaughtFailure;
+  
+  /*! \brief Designator logged in the context of a node
+    
+    The description is free-form data and is owned by the node. */
+  typedef struct {
+    std::string strType;
+    std::string strID;
+    std::string strAnnotation;
+    KeyValuePair* ckvpDescription;
+  } NodeDesignator;
+  
+  /*! \brief Callback interface for walking a node tree
+    
+    Passed to Node::accept(). enterNode() is called before a node's
+    sub-nodes are visited (pre-order), leaveNode() after them
+    (post-order). Returning false from enterNode() skips the
+    sub-nodes of that node; leaveNode() is still called for it. */
+  class NodeVisitor {
+  public:
+    virtual ~NodeVisitor() {}
+    
+    virtual bool enterNode(Node* ndNode) { return true; }
+    virtual void leaveNode(Node* ndNode) {}
+  };
+  
   /*! \brief Class describing a single node entity
     
     Nodes are the basic building block of task trees. They can have
     (meta-)properties, a title, a unique ID, and sub nodes. They also
     know about their parent node to ease tree processing. */
   class Node {
+    friend class NodeArena;
+    
   private:
     /*! \brief The string title of the current node
       
@@ -84,21 +134,50 @@ namespace semrec {
      triggers logging mechanisms. This is custom data and its fields
      can be set via the designator interface. */
     std::list<KeyValuePair*> m_lstDescription;
-    /*! \brief List of this node's sub-nodes */
-    std::list<Node*> m_lstSubnodes;
-    /*! \brief This nide's meta information
-     
-     This meta-information includes when a node context was started
-     and ended (timestamps), what its success value was, and similar
-     meta-information. This is automatically set by the system. */
-    KeyValuePair* m_ckvpMetaInformation;
+    /*! \brief This node's sub-nodes, in the order they were added */
+    std::vector<Node*> m_vecSubnodes;
+    /*! \brief Neighbouring sub-nodes of this node's parent */
+    Node* m_ndPreviousSibling;
+    Node* m_ndNextSibling;
+    /*! \brief Position of this node in its parent's sub-nodes */
+    unsigned int m_unIndexInParent;
+    /*! \brief Bit flags describing the node's state (see NodeFlag) */
+    unsigned char m_ucFlags;
+    /*! \brief Detail level of this node; higher values denote finer grained nodes */
+    int m_nDetailLevel;
+    /*! \brief Start and end time of this node's context
+      
+      The numeric values are used for comparisons, the strings hold
+      the timestamps as they were recorded (with the precision
+      configured at that time) and serve as timepoint identifiers
+      when exporting. */
+    double m_dTimeStart;
+    double m_dTimeEnd;
+    std::string m_strTimeStart;
+    std::string m_strTimeEnd;
+    std::string m_strTimeStartSystem;
+    /*! \brief Explicitly set (OWL) class of this node, if any */
+    std::string m_strClass;
+    std::string m_strClassNamespace;
+    
+    /*! \brief Attachments collected while this node was active */
+    std::vector<NodeImage> m_vecImages;
+    std::vector<KeyValuePair*> m_vecObjects;
+    std::vector<KeyValuePair*> m_vecHumans;
+    std::vector<NodeFailure> m_vecFailures;
+    std::vector<NodeCaughtFailure> m_vecCaughtFailures;
+    std::vector<NodeDesignator> m_vecDesignators;
+    
+    /*! \brief Compatibility view of this node's state
+      
+      Rebuilt from the typed fields on demand by metaInformation(). */
+    KeyValuePair m_ckvpMetaInformation;
+    bool m_bMetaInformationDirty;
     
-    /*! \brief List of failures caught by this node, and their emitters
+    /*! \brief Whether this node deletes its sub-nodes when destroyed
       
-      Nodes can act as failure handling nodes. When the external plan
-      system signals that a node caught a formerly thrown failure, the
-      respective emitter and the failure type are denoted here. */
-    std::list< std::pair<std::string, Node*> > m_lstCaughtFailures;
+      Nodes created by a NodeArena don't; the arena destroys them. */
+    bool m_bOwnsSubnodes;
     
     /*! \brief Central initialization method for the Node class */
     void init();
@@ -113,8 +192,21 @@ namespace semrec {
       This is a clean-up method and is called by the system
       automatically. */
     void clearSubnodes();
+    /*! \brief Deletes the attachments owned by this node */
+    void clearAttachments();
+    
+    void setFlag(unsigned char ucFlag, bool bSet);
+    bool flag(unsigned char ucFlag);
     
   public:
+    /*! \brief Flags stored in a node's state */
+    enum NodeFlag {
+      NF_SUCCESS = 1,
+      NF_PREMATURELY_ENDED = 2,
+      NF_HAS_TIME_START = 4,
+      NF_HAS_TIME_END = 8
+    };
+    
     /*! \brief Constructur for generating an empty node */
     Node();
     /*! \brief Constructor for generating a title'd node */
@@ -158,6 +250,8 @@ namespace semrec {
       \return The pointer to this node's parent node instance */
     Node* parent();
     Node* relativeWithID(int nID, bool bIgnoreSelf = false);
+    /*! \brief Returns whether ndAncestor is a (direct or indirect) parent of this node */
+    bool hasAncestor(Node* ndAncestor);
     
     /*! \brief Add a sub-node to this node
       
@@ -167,10 +261,29 @@ namespace semrec {
       
       \param ndAdd The node instance to add as branch */
     void addSubnode(Node* ndAdd);
-    /*! \brief Return the list of sub-nodes for this node
+    /*! \brief Return the sub-nodes of this node
       
-      \return List of Node instances that are held as branching nodes for this Node instance */
-    std::list<Node*> subnodes();
+      The returned reference stays valid until sub-nodes are added to
+      this node; it does not copy the sub-nodes.
+      
+      \return Node instances that are held as branching nodes for this Node instance */
+    const std::vector<Node*>& subnodes();
+    unsigned int subnodeCount();
+    Node* firstSubnode();
+    Node* lastSubnode();
+    
+    Node* previousSibling();
+    Node* nextSibling();
+    /*! \brief Return this node's position in its parent's sub-nodes (0 for root nodes) */
+    unsigned int indexInParent();
+    
+    /*! \brief Walk this node and all nodes below it
+      
+      The walk follows the sibling links, so it neither recurses nor
+      allocates.
+      
+      \param nvVisitor Visitor that is called for every node */
+    void accept(NodeVisitor& nvVisitor);
     
     void setUniqueID(std::string strUniqueID);
     std::string uniqueID();
@@ -182,12 +295,45 @@ namespace semrec {
     
     bool includesUniqueID(std::string strUniqueID);
     
+    /*! \brief Returns the node's state in the former key/value layout
+      
+      This is a compatibility accessor for plugins that still read
+      `success', `time-start', `images', etc. by key. The returned
+      structure is a read-only view that is rebuilt from the typed
+      fields when they changed; modifying it has no effect on the
+      node. New code should use the typed accessors instead. */
     KeyValuePair* metaInformation();
     
     void setPrematurelyEnded(bool bPrematurelyEnded);
     bool prematurelyEnded();
     
-    KeyValuePair* addDescriptionListItem(std::string strDomain, std::string strPrefix);
+    void setDetailLevel(int nDetailLevel);
+    int detailLevel();
+    
+    void setClass(std::string strClass, std::string strClassNamespace = "");
+    std::string className();
+    std::string classNamespace();
+    
+    void setTimeStart(double dTimeStart, std::string strTimeStart);
+    double timeStart();
+    std::string timeStartString();
+    bool hasTimeStart();
+    
+    void setTimeEnd(double dTimeEnd, std::string strTimeEnd);
+    double timeEnd();
+    std::string timeEndString();
+    bool hasTimeEnd();
+    
+    void setTimeStartSystem(std::string strTimeStartSystem);
+    std::string timeStartSystemString();
+    
+    const std::vector<NodeImage>& images();
+    const std::vector<KeyValuePair*>& objects();
+    const std::vector<KeyValuePair*>& humans();
+    const std::vector<NodeFailure>& failures();
+    const std::vector<NodeCaughtFailure>& caughtFailures();
+    const std::vector<NodeDesignator>& designators();
+    
     std::string addImage(std::string strOrigin, std::string strFilename, std::string strTimestamp);
     std::string addObject(std::list<KeyValuePair*> lstDescription);
     std::string addHuman(std::list<KeyValuePair*> lstDescription);
@@ -203,8 +349,6 @@ namespace semrec {
     bool success();
     
     Node* previousNode();
-    
-    void ensureProperty(std::string strKey, std::string strDefaultValue);
   };
 }
 
@@ -0,0 +1,115 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __NODE_ARENA_H__
+#define __NODE_ARENA_H__
+
+
+// System
+#include <string>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <new>
+#include <atomic>
+
+// Private
+#include <semrec/Node.h>
+
+
+namespace semrec {
+  /*! \brief Owns all nodes of one experiment's task tree
+    
+    Nodes are placed into large, contiguous blocks instead of being
+    heap-allocated one by one. Nodes created here don't delete their
+    sub-nodes; the arena destroys all of them in one flat pass when
+    it is cleared (e.g. when a new experiment starts), without
+    recursing through the tree. All nodes of a tree built from an
+    arena have to come from that arena. */
+  class NodeArena {
+  private:
+    /*! \brief Storage blocks, each holding m_unNodesPerBlock nodes */
+    std::vector<Node*> m_vecBlocks;
+    /*! \brief Number of nodes per storage block */
+    unsigned int m_unNodesPerBlock;
+    /*! \brief Number of constructed nodes in the last block */
+    unsigned int m_unUsedInLastBlock;
+    /*! \brief Whether the experiment these nodes belong to is over */
+    std::atomic<bool> m_bRetired;
+    
+    /*! \brief Creates a copy of ndOriginal's own state, without its sub-nodes */
+    Node* copyNode(Node* ndOriginal);
+    
+  public:
+    NodeArena(unsigned int unNodesPerBlock = 4096);
+    ~NodeArena();
+    
+    /*! \brief Creates a new, title'd node owned by this arena */
+    Node* createNode(std::string strTitle);
+    
+    /*! \brief Copies the trees below lstRoots into this arena
+      
+      The copies don't share any data with the originals, so they
+      can be read on other threads while the originals keep
+      changing. Caught failures point to the copy of their emitter;
+      emitters outside the copied trees become NULL.
+      
+      \param lstRoots The root nodes of the trees to copy
+      \param mapCopies Filled with the copy of every copied node
+      \return The copied root nodes, in the order of lstRoots */
+    std::list<Node*> copyTrees(std::list<Node*> lstRoots, std::unordered_map<Node*, Node*>& mapCopies);
+    
+    /*! \brief Destroys all nodes in this arena
+      
+      The first storage block is kept for the next experiment, all
+      others are released. */
+    void clear();
+    
+    /*! \brief Returns the number of nodes currently in this arena */
+    unsigned int size();
+    
+    /*! \brief Marks the nodes in this arena as belonging to a past experiment
+      
+      The nodes stay valid for whoever still holds the arena, but
+      events referring to them are outdated. */
+    void retire();
+    bool retired();
+  };
+}
+
+
+#endif /* __NODE_ARENA_H__ */
@@ -0,0 +1,143 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __OUTPUT_SINK_H__
+#define __OUTPUT_SINK_H__
+
+
+// System
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+
+namespace semrec {
+  /*! \brief Destination for generated exporter output
+    
+    Generators write their output piece by piece into a sink instead
+    of returning (and concatenating) strings, so the complete
+    document never has to be held in memory. */
+  class OutputSink {
+  public:
+    virtual ~OutputSink() {}
+    
+    virtual bool write(const char* acData, size_t szLength) = 0;
+    
+    bool write(const std::string& strData) {
+      return this->write(strData.data(), strData.length());
+    }
+    
+    OutputSink& operator<<(const std::string& strData) {
+      this->write(strData.data(), strData.length());
+      
+      return *this;
+    }
+    
+    OutputSink& operator<<(const char* acData) {
+      this->write(acData, strlen(acData));
+      
+      return *this;
+    }
+  };
+  
+  /*! \brief Sink collecting all output in a string */
+  class StringOutputSink : public OutputSink {
+  private:
+    std::string m_strContent;
+    
+  public:
+    StringOutputSink();
+    ~StringOutputSink();
+    
+    using OutputSink::write;
+    virtual bool write(const char* acData, size_t szLength);
+    
+    const std::string& content();
+    void clear();
+  };
+  
+  /*! \brief Sink writing to a file through a large, page aligned buffer
+    
+    Output is collected in the buffer and handed to the operating
+    system in buffer sized chunks; writes larger than the buffer
+    bypass it. Once a write fails, the writer stays failed (see
+    good()) and ignores further output. */
+  class BufferedFileWriter : public OutputSink {
+  private:
+    int m_nFileDescriptor;
+    char* m_acBuffer;
+    size_t m_szBufferSize;
+    size_t m_szBuffered;
+    unsigned long long m_ullBytesWritten;
+    bool m_bGood;
+    
+    bool writeThrough(const char* acData, size_t szLength);
+    
+  public:
+    BufferedFileWriter(size_t szBufferSize = 1 << 20);
+    ~BufferedFileWriter();
+    
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+    
+    bool open(std::string strFilename, bool bAppend = false);
+    /*! \brief Flushes the buffer and closes the file
+      
+      Returns whether all output made it into the file. */
+    bool close();
+    bool isOpen();
+    bool good();
+    
+    using OutputSink::write;
+    virtual bool write(const char* acData, size_t szLength);
+    bool flush();
+    
+    /*! \brief Copies the contents of another file to the output
+      
+      Used to splice separately generated parts into a document
+      without loading them into memory. */
+    bool appendFileContents(std::string strFilename);
+    
+    unsigned long long bytesWritten();
+  };
+}
+
+
+#endif /* __OUTPUT_SINK_H__ */
@@ -44,7 +44,13 @@
 // System
 #include <cstdlib>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
 #include <list>
+#include <limits>
+#include <unordered_set>
+#include <unordered_map>
 #include <string>
 #include <sstream>
 
@@ -52,6 +58,7 @@
 #include <semrec/Types.h>
 #include <semrec/ForwardDeclarations.h>
 #include <semrec/ArbitraryMappingsHolder.h>
+#include <semrec/MPSCQueue.h>
 
 
 using namespace designator_integration;
@@ -60,6 +67,10 @@ using namespace designator_integration;
 namespace semrec {
   namespace plugins {
     class Plugin : public ArbitraryMappingsHolder {
+    public:
+      /*! \brief Continuation invoked with the response to an asynchronous service request */
+      typedef std::function<void(const ServiceEvent&)> ResponseHandler;
+      
     private:
       std::list<std::string> m_lstDependencies;
       std::string m_strName;
@@ -69,17 +80,30 @@ namespace semrec {
       bool m_bRunCycle;
       std::mutex m_mtxRunCycle;
       bool m_bDevelopmentPlugin;
+      bool m_bDedicatedCycleThread;
+      bool m_bParallelDispatch;
+      std::string m_strDispatchOrderingKey;
+      bool m_bPendingCycleData;
+      std::function<void()> m_fncCycleRequested;
+      std::mutex m_mtxPendingCycleData;
+      std::condition_variable m_cvPendingCycleData;
+      std::mutex m_mtxSubscriptions;
+      int m_nNextRequestID;
+      std::unordered_set<int> m_setOpenRequestIDs;
+      std::unordered_set<int> m_setAwaitedServiceEventIDs;
+      std::unordered_map<int, ServiceEvent> m_mapReceivedServiceEventResponses;
+      std::unordered_map<int, ResponseHandler> m_mapResponseHandlers;
+      std::mutex m_mtxPendingResponses;
+      std::condition_variable m_cvPendingResponses;
+      
+      int nextCorrelationID(int& nCounter);
+      void notifyPendingResponses();
       
     protected:
-      std::list<Event> m_lstEvents;
-      std::mutex m_mtxEventsStore;
+      MPSCQueue<Event> m_mqEvents;
       std::list<std::string> m_lstSubscribedEventNames;
-      std::list<ServiceEvent> m_lstServiceEvents;
-      std::mutex m_mtxServiceEventsStore;
+      MPSCQueue<ServiceEvent> m_mqServiceEvents;
       std::list<std::string> m_lstOfferedServices;
-      std::list<int> m_lstOpenRequestIDs;
-      std::list<ServiceEvent> m_lstReceivedServiceEventResponses;
-      std::mutex m_mtxReceivedServiceEventResponses;
       
     public:
       Plugin();
@@ -107,13 +131,51 @@ namespace semrec {
       void setIsDeprecated(bool bIsDeprecated);
       bool isDeprecated();
       
+      /*! \brief Requests a thread of its own for this plugin's cycle
+	
+	By default, cycle() runs as a task on the shared plugin
+	executor and must not block for long. Plugins that do blocking
+	work in cycle() should set this in their constructor. */
+      void setDedicatedCycleThread(bool bDedicatedCycleThread);
+      bool dedicatedCycleThread();
+      
+      /*! \brief Declares that events may be consumed off the core thread
+	
+	When `parallel-dispatch' is enabled in the configuration,
+	events (and responses to this plugin's service requests) are
+	then delivered on the worker threads instead of the core
+	thread. They still arrive in order and one at a time, but
+	concurrently to the core thread and to other plugins. Requests
+	for services the plugin offers are still handled on the core
+	thread. Such plugins must not touch nodes of the live task
+	tree from consumeEvent(); plan trees they request should be
+	snapshots (see `symbolic-plan-tree'). */
+      void setParallelDispatch(bool bParallelDispatch);
+      bool parallelDispatch();
+      /*! \brief Serializes parallel deliveries with other plugins
+	
+	Plugins declaring the same (non-empty) key receive their
+	events one at a time in common, for example because they
+	write to the same resource. Without a key, a plugin is only
+	serialized with itself. */
+      void setDispatchOrderingKey(std::string strDispatchOrderingKey);
+      std::string dispatchOrderingKey();
+      
       void setSubscribedToEvent(std::string strEventName, bool bSubscribed);
       bool subscribedToEvent(std::string strEventName);
-      virtual void consumeEvent(Event evEvent);
+      std::list<std::string> subscribedEventNames();
+      virtual void consumeEvent(const Event& evEvent);
       
       void setOffersService(std::string strServiceName, bool bOffering);
       bool offersService(std::string strServiceName);
-      virtual Event consumeServiceEvent(ServiceEvent seServiceEvent);
+      std::list<std::string> offeredServices();
+      virtual Event consumeServiceEvent(const ServiceEvent& seServiceEvent);
+      /*! \brief Hands a service event to this plugin
+	
+	Responses to requests issued through requestService() go to
+	their response handler; everything else is passed on to
+	consumeServiceEvent(). */
+      Event dispatchServiceEvent(const ServiceEvent& seServiceEvent);
       
       void addDependency(std::string strPluginName);
       bool dependsOn(std::string strPluginName);
@@ -121,8 +183,24 @@ namespace semrec {
       
       void deployCycleData(Result& resDeployTo);
       
-      void deployEvent(Event evDeploy, bool bWaitForEvent = false);
-      ServiceEvent deployServiceEvent(ServiceEvent seDeploy, bool bWaitForEvent = false);
+      /*! \brief Wakes up the cycle thread of this plugin, or schedules its cycle */
+      void notifyPendingCycleData();
+      /*! \brief Sets the function called whenever this plugin has data to deploy */
+      void setCycleRequestHandler(std::function<void()> fncCycleRequested);
+      /*! \brief Blocks until data was deployed or fTimeout seconds passed
+	
+	Returns whether data is pending. */
+      bool waitForPendingCycleData(float fTimeout);
+      
+      void deployEvent(Event evDeploy, bool bWaitForEvent = false, float fTimeout = 0.0);
+      ServiceEvent deployServiceEvent(ServiceEvent seDeploy, bool bWaitForEvent = false, float fTimeout = 0.0);
+      /*! \brief Deploys a service request without blocking
+	
+	rhHandler is called with the response once it arrives, on the
+	core thread. This keeps request and response handling in one
+	place without blocking a thread per request. */
+      ServiceEvent requestService(ServiceEvent seRequest, ResponseHandler rhHandler);
+      ServiceEvent requestService(std::string strServiceName, Designator* cdDesignator, ResponseHandler rhHandler);
       
       std::string pluginIdentifierString(bool bBold);
       
@@ -134,8 +212,18 @@ namespace semrec {
       void setRunning(bool bRunCycle);
       bool running();
       
-      void waitForEvent(Event evWait);
-      ServiceEvent waitForEvent(ServiceEvent seWait);
+      /*! \brief Blocks until the request ID of evWait was closed
+	
+	Waits at most fTimeout seconds (forever if fTimeout <= 0) and
+	returns early when the plugin stops running. Returns whether
+	the request was closed. */
+      bool waitForEvent(Event evWait, float fTimeout = 0.0);
+      /*! \brief Blocks until the response to seWait arrived
+	
+	Only responses to requests deployed with bWaitForEvent are
+	kept. On timeout (fTimeout <= 0 waits forever) or when the
+	plugin stops running, a default service event is returned. */
+      ServiceEvent waitForEvent(ServiceEvent seWait, float fTimeout = 0.0);
       
       void success(std::string strMessage, bool bImportant = false);
       void info(std::string strMessage, bool bImportant = false);
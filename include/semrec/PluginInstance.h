@@ -48,12 +48,17 @@
 #include <string>
 #include <dlfcn.h>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
 
 // Private
 #include <semrec/Types.h>
 #include <semrec/ForwardDeclarations.h>
 #include <semrec/Plugin.h>
 #include <semrec/UtilityBase.h>
+#include <semrec/WorkerPool.h>
 
 
 namespace semrec {
@@ -64,9 +69,24 @@ namespace semrec {
     std::string m_strName;
     std::thread* m_thrdPluginCycle;
     bool m_bRunCycle;
+    WorkerPool* m_wpExecutor;
+    bool m_bCycleScheduled;
+    bool m_bCycleRequested;
+    /*! \brief When the last cycle on the executor finished */
+    std::chrono::steady_clock::time_point m_tpLastCycle;
+    float m_fMaxCycleLatency;
+    std::mutex m_mtxCycleSchedule;
+    std::condition_variable m_cvCycleSchedule;
     std::mutex m_mtxCycleResults;
     Result m_resCycleResult;
     
+    void scheduleCycle();
+    void runScheduledCycle();
+    void runCycleOnce();
+    
+    void deliverEvent(Event evEvent);
+    void deliverServiceEvent(ServiceEvent seServiceEvent, bool bOwnsDesignator);
+    
   public:
     PluginInstance();
     ~PluginInstance();
@@ -80,14 +100,33 @@ namespace semrec {
     int pluginID();
     
     Result init(int argc, char** argv);
-    Result cycle();
+    /*! \brief Drives the plugin's cycle and returns what it deployed since the last call
+      
+      The cycle runs as a task on wpExecutor, or on a thread of its
+      own if wpExecutor is NULL or the plugin asked for one. On
+      wpExecutor, cycles run when the plugin requests one, and every
+      `max-cycle-latency' seconds if it didn't. */
+    Result cycle(WorkerPool* wpExecutor = NULL);
     void spinCycle();
     std::list<std::string> dependencies();
     
     bool subscribedToEvent(std::string strEventName);
-    void consumeEvent(Event evEvent);
+    std::list<std::string> subscribedEventNames();
+    void consumeEvent(const Event& evEvent);
     bool offersService(std::string strServiceName);
-    Event consumeServiceEvent(ServiceEvent seServiceEvent);
+    std::list<std::string> offeredServices();
+    Event consumeServiceEvent(const ServiceEvent& seServiceEvent);
+    
+    bool parallelDispatch();
+    std::string dispatchOrderingKey();
+    /*! \brief Delivers an event on wsStrand instead of the calling thread
+      
+      The queued delivery works on its own copy of the event's
+      designator, as the core deletes the original right after
+      dispatching. */
+    void queueEvent(const Event& evEvent, WorkerStrand* wsStrand);
+    /*! \brief Delivers a service event on wsStrand; its result is discarded */
+    void queueServiceEvent(const ServiceEvent& seServiceEvent, WorkerStrand* wsStrand);
     
     std::string name();
     
@@ -46,17 +46,32 @@
 #include <cstdlib>
 #include <list>
 #include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
 
 // Private
 #include <semrec/ForwardDeclarations.h>
 #include <semrec/Types.h>
 #include <semrec/PluginInstance.h>
 #include <semrec/UtilityBase.h>
+#include <semrec/WorkerPool.h>
 
 
 namespace semrec {
   class PluginSystem : public UtilityBase {
   private:
+    /*! \brief Subscription index entry for one event or service identifier
+      
+      Holds the name the entry was built from, so dispatching needs a
+      single lookup to both find the plugins and tell a matching name
+      from a name that only shares its identifier. */
+    typedef struct {
+      std::string strName;
+      std::vector<PluginInstance*> vecPlugins;
+    } IndexEntry;
+    
+
     std::list<PluginInstance*> m_lstLoadedPlugins;
     std::list<PluginInstance*> m_lstUnloadPlugins;
     std::list<std::string> m_lstLoadFailedPlugins;
@@ -64,6 +79,25 @@ namespace semrec {
     int m_argc;
     char** m_argv;
     bool m_bLoadDevelopmentPlugins;
+    /*! \brief Shared executor for plugin cycles */
+    WorkerPool* m_wpExecutor;
+    /*! \brief Whether plugins may opt into receiving events on m_wpExecutor */
+    bool m_bParallelDispatch;
+    /*! \brief Strands for parallel deliveries, by ordering key (or plugin name) */
+    std::map<std::string, WorkerStrand*> m_mapDispatchStrands;
+    /*! \brief Subscribed plugins per event name, in loading order */
+    std::unordered_map<EventID, IndexEntry> m_mapEventSubscribers;
+    /*! \brief Offering plugins per service name, in loading order */
+    std::unordered_map<EventID, IndexEntry> m_mapServiceProviders;
+    bool m_bSubscriptionIndexValid;
+    unsigned long m_unSubscriptionIndexGeneration;
+    
+    /*! \brief Rebuilds the subscription index if plugins changed their subscriptions or offered services */
+    void ensureSubscriptionIndex();
+    /*! \brief Returns the strand to deliver piPlugin's events on, or NULL to deliver them inline */
+    WorkerStrand* dispatchStrand(PluginInstance* piPlugin);
+    /*! \brief Waits until all parallel deliveries are done */
+    void waitForDispatch();
     
   public:
     PluginSystem(int argc, char** argv);
@@ -72,13 +106,18 @@ namespace semrec {
     void setLoadDevelopmentPlugins(bool bLoadDevelopmentPlugins);
     bool loadDevelopmentPlugins();
     
+    /*! \brief Sets the number of executor threads (0 means one per core) */
+    void setWorkerThreads(unsigned int unThreads);
+    /*! \brief Allows plugins that opted in to receive events on the executor threads */
+    void setParallelDispatch(bool bParallelDispatch);
+    
     std::string pluginNameFromPath(std::string strPath);
     bool pluginLoaded(std::string strPluginName);
     Result loadPluginLibrary(std::string strFilepath, bool bIsNameOnly = false);
     void queueUnloadPluginInstance(PluginInstance* icUnload);
     
-    int spreadEvent(Event evEvent);
-    int spreadServiceEvent(ServiceEvent seServiceEvent);
+    int spreadEvent(const Event& evEvent);
+    int spreadServiceEvent(const ServiceEvent& seServiceEvent);
     Result cycle();
     
     void addPluginSearchPaths(std::list<std::string> lstPaths);
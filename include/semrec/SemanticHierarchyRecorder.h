@@ -218,7 +218,7 @@ namespace semrec {
       
       \return Boolean signalling whether at least one subscriber
       consumes the event. */
-    bool spreadEvent(Event evEvent);
+    bool spreadEvent(const Event& evEvent);
     
     /*! \brief Spread incoming system service events to all subscribing plugins.
       
@@ -229,7 +229,7 @@ namespace semrec {
 
       \param seServiceEvent The service event to spread among
       subscribers (and receivers of replies). */
-    void spreadServiceEvent(ServiceEvent seServiceEvent);
+    void spreadServiceEvent(const ServiceEvent& seServiceEvent);
     
     /*! \brief Main cycle method, maintaining core functionality for the system.
       
@@ -273,7 +273,7 @@ namespace semrec {
     std::string homeDirectory();
     
     virtual std::list<std::string> findTokenReplacements(std::string strToken);
-    bool handleUnhandledEvent(Event evEvent);
+    bool handleUnhandledEvent(const Event& evEvent);
     
     std::list<std::string> findPrefixPaths(std::string strPathList, std::string strMatchingSuffix, std::string strDelimiter = ":");
     
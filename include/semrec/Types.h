@@ -47,9 +47,12 @@
 #include <designators/Designator.h>
 #include <vector>
 #include <map>
+#include <memory>
 
 // Private
 #include <semrec/Node.h>
+#include <semrec/EventID.h>
+#include <semrec/DesignatorRegistry.h>
 
 
 using namespace designator_integration;
@@ -57,6 +60,7 @@ using namespace designator_integration;
 
 namespace semrec {
   class PluginInstance;
+  class NodeArena;
   
   typedef struct {
     typedef enum {
@@ -130,6 +134,24 @@ namespace semrec {
     std::string strMessage;
   } StatusMessage;
   
+  /*! \brief Bulky plan tree payload for Events
+    
+    Mostly plan tree queries (such as the `symbolic-plan-tree'
+    service) fill these. They are carried out of line, so copying an Event
+    that refers to them only copies a shared pointer. */
+  typedef struct {
+    std::list<Node*> lstRootNodes;
+    /*! \brief Snapshot of the logged designators and their equations */
+    std::shared_ptr<const DesignatorRegistry> drDesignators;
+    /*! \brief Arena owning the nodes, if set
+      
+      Keeps the nodes valid for as long as the data is held. Set for
+      snapshots copied out of the live tree, and for events about
+      live nodes that may be dispatched after their experiment ended
+      (see NodeArena::retired()). */
+    std::shared_ptr<NodeArena> naNodes;
+  } PlanTreeData;
+  
   /*! \brief Central Event structure, allowing information flow between components */
   typedef struct {
     /*! \brief The event's identifier
@@ -140,12 +162,21 @@ namespace semrec {
       types of events, only receiving the types they actually
       subscribed to. */
     std::string strEventName;
+    /*! \brief Interned identifier of strEventName
+      
+      Set by defaultEvent() and refreshed when the event is
+      deployed. */
+    EventID eiEventID;
     int nContextID;
     /*! \brief An optional designator to accompany the event
       
       Designators can hold arbitrary information for an event and helps
       receiving components to process them. */
     Designator* cdDesignator;
+    /*! \brief Optional plain string payload
+      
+      Used by events that only carry a single value, such as the
+      timestamps of `update-absolute-experiment-*-time'. */
     std::string strSupplementary;
     /*! \brief Optional extra annotation for this event */
     std::string strAnnotation;
@@ -154,14 +185,17 @@ namespace semrec {
     int nOpenRequestID;
     bool bRequest;
     bool bPreempt;
-    StatusMessage msgStatusMessage;
-    /*! \brief Node references accompanying this event */
+    /*! \brief Node references accompanying this event
+      
+      Kept inline rather than in the shared payload: most events
+      carry a single node, and events are moved (not copied) on
+      their way to the subscribers when deployed with std::move, so
+      an out of line list would add an allocation instead of saving
+      one. */
     std::list<Node*> lstNodes;
-    std::list<Node*> lstRootNodes;
-    std::list< std::pair<std::string, std::string> > lstDesignatorIDs;
-    std::list< std::pair<std::string, std::string> > lstEquations;
-    std::list< std::pair<std::string, std::string> > lstEquationTimes;
-    int nSequenceNumber;
+    /*! \brief Optional plan tree payload, shared between copies */
+    std::shared_ptr<const PlanTreeData> ptdPlanTree;
+    unsigned long nSequenceNumber;
   } Event;
   
   /*! \brief Central ServiceEvent structure, allowing asynchronous services between components */
@@ -169,12 +203,14 @@ namespace semrec {
     ServiceIdentifier siServiceIdentifier;
     ServiceModifier smResultModifier;
     std::string strServiceName;
+    /*! \brief Interned identifier of strServiceName */
+    EventID eiServiceID;
     int nServiceEventID;
     bool bPreserve;
     int nRequesterID;
     Designator* cdDesignator;
     std::list<Event> lstResultEvents;
-    int nSequenceNumber;
+    unsigned long nSequenceNumber;
   } ServiceEvent;
   
   /*! \brief Central Result container for requests of all types
@@ -226,6 +262,13 @@ namespace semrec {
     bool bDisplayUnhandledEvents;
     bool bDisplayUnhandledServiceEvents;
     bool bOnlyDisplayImportant;
+    
+    // Cycle wakeups
+    float fMaxCycleLatency;
+    
+    // Plugin execution
+    int nWorkerThreads;
+    bool bParallelDispatch;
   } ConfigSettings;
 }
 
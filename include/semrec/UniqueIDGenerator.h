@@ -0,0 +1,89 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __UNIQUE_ID_GENERATOR_H__
+#define __UNIQUE_ID_GENERATOR_H__
+
+
+// System
+#include <string>
+#include <atomic>
+#include <random>
+
+
+namespace semrec {
+  /*! \brief Issues unique identifiers in constant time
+    
+    Identifiers consist of a prefix, a random salt that is drawn once
+    per generator (and again on reset()), and a running counter, all
+    encoded in the alphanumeric characters [0-9A-Za-z] that random
+    identifiers used so far. Identifiers from the same generator never
+    collide (for the first 62^6 identifiers per salt), and the salt
+    keeps identifiers from different generators or experiments apart
+    without having to check them against existing ones. */
+  class UniqueIDGenerator {
+  private:
+    /*! \brief Random characters making this generator's identifiers distinct */
+    std::string m_strSalt;
+    /*! \brief Number of identifiers issued since the last reset */
+    std::atomic<unsigned long long> m_ullCounter;
+    
+    static const unsigned int s_unMinCounterDigits = 6;
+    static const unsigned int s_unSaltLength = 32;
+    
+    static char encodeDigit(unsigned int unDigit);
+    
+  public:
+    UniqueIDGenerator();
+    ~UniqueIDGenerator();
+    
+    /*! \brief Draws a new salt and restarts the counter
+      
+      Must not be called while other threads issue identifiers from
+      this generator. */
+    void reset();
+    
+    /*! \brief Returns a new identifier
+      
+      \param strPrefix Prefix to prepend to the identifier
+      \param unLength Number of characters following the prefix; identifiers get longer only when the counter needs more digits */
+    std::string uniqueID(std::string strPrefix, unsigned int unLength = 16);
+  };
+}
+
+
+#endif /* __UNIQUE_ID_GENERATOR_H__ */
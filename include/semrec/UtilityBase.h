@@ -46,17 +46,54 @@
 #include <string>
 #include <fstream>
 #include <chrono>
+#include <sstream>
+#include <locale>
 
 // Private
 #include <semrec/Types.h>
 #include <semrec/ForwardDeclarations.h>
 
 
+/*! \brief Compile-time floor for console messages
+  
+  Messages issued through the SEMREC_* macros below this level are
+  removed by the compiler altogether (including the construction of
+  their message strings). 0 keeps everything, 3 only keeps failures. */
+#ifndef SEMREC_LOG_MIN_LEVEL
+#define SEMREC_LOG_MIN_LEVEL 0
+#endif
+
+/*! \brief Level-gated message output
+  
+  Only evaluates the message expression if a message of the given
+  level would actually be shown, so no strings are built for
+  suppressed messages. Must be used from inside a UtilityBase
+  subclass. */
+#define SEMREC_MESSAGE(level, method, msg, important) \
+  do { \
+    if((level) >= SEMREC_LOG_MIN_LEVEL && this->messageEnabled((level), (important))) { \
+      this->method((msg), (important)); \
+    } \
+  } while(0)
+
+#define SEMREC_INFO(msg) SEMREC_MESSAGE(semrec::ML_INFO, info, msg, false)
+#define SEMREC_SUCCESS(msg) SEMREC_MESSAGE(semrec::ML_SUCCESS, success, msg, false)
+#define SEMREC_WARN(msg) SEMREC_MESSAGE(semrec::ML_WARN, warn, msg, false)
+#define SEMREC_FAIL(msg) SEMREC_MESSAGE(semrec::ML_FAIL, fail, msg, false)
+
+
 namespace semrec {
+  typedef enum {
+    ML_INFO = 0,
+    ML_SUCCESS = 1,
+    ML_WARN = 2,
+    ML_FAIL = 3
+  } MessageLevel;
+  
   class UtilityBase {
   private:
-    static bool m_bRedirectOutput;
     static bool m_bQuiet;
+    static MessageLevel m_mlMinimumLevel;
     std::string m_strMessagePrefixLabel;
     bool m_bOnlyDisplayImportant;
     int m_nTimeFloatingPointPrecision;
@@ -80,6 +117,18 @@ namespace semrec {
     void setOnlyDisplayImportant(bool bOnly);
     bool onlyDisplayImportant();
     
+    void setMinimumMessageLevel(MessageLevel mlLevel);
+    MessageLevel minimumMessageLevel();
+    bool messageLevelFromString(std::string strLevel, MessageLevel& mlLevel);
+    
+    /*! \brief Whether a message would currently be shown at all
+      
+      Cheap enough to call before building a message string; the
+      SEMREC_* macros do exactly that. */
+    inline bool messageEnabled(MessageLevel mlLevel, bool bImportant = false) {
+      return !m_bQuiet && mlLevel >= m_mlMinimumLevel && (!m_bOnlyDisplayImportant || bImportant);
+    }
+    
     bool fileExists(std::string strFileName);
     
     std::string stripPostfix(std::string strString, std::string strPostfix);
@@ -0,0 +1,120 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+
+// System
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+
+namespace semrec {
+  /*! \brief Fixed size, work-stealing pool of worker threads
+    
+    Every worker owns a task queue. Tasks enqueued from a worker go
+    to its own queue (and are taken from the back, while they are
+    still warm), tasks from other threads are distributed round
+    robin. Idle workers steal from the front of the other queues
+    before going to sleep. No ordering is guaranteed between tasks;
+    callers that need ordering have to serialize their tasks
+    themselves (see PluginInstance::scheduleCycle, or use a
+    WorkerStrand). */
+  class WorkerPool {
+  private:
+    typedef struct {
+      std::deque< std::function<void()> > dqTasks;
+      std::mutex mtxTasks;
+      std::thread* thrdWorker;
+    } Worker;
+    
+    std::vector<Worker*> m_vecWorkers;
+    std::atomic<unsigned int> m_unPendingTasks;
+    std::atomic<unsigned int> m_unNextWorker;
+    std::mutex m_mtxIdle;
+    std::condition_variable m_cvIdle;
+    bool m_bRun;
+    
+    void work(unsigned int unWorker);
+    bool takeTask(unsigned int unWorker, std::function<void()>& fncTask);
+    
+  public:
+    WorkerPool(unsigned int unThreads);
+    ~WorkerPool();
+    
+    /*! \brief Queues a task for execution on one of the workers */
+    void enqueue(std::function<void()> fncTask);
+    /*! \brief Finishes all queued tasks and joins the workers */
+    void shutdown();
+    
+    unsigned int threadCount();
+  };
+  
+  /*! \brief Runs tasks on a WorkerPool one at a time, in the order they were enqueued
+    
+    At most one task draining a strand is queued on the pool at any
+    time. Tasks of one strand therefore never run concurrently to
+    each other, while different strands share the pool's workers. */
+  class WorkerStrand {
+  private:
+    WorkerPool* m_wpPool;
+    std::deque< std::function<void()> > m_dqTasks;
+    bool m_bDraining;
+    std::mutex m_mtxTasks;
+    std::condition_variable m_cvDrained;
+    
+    void drain();
+    
+  public:
+    WorkerStrand(WorkerPool* wpPool);
+    ~WorkerStrand();
+    
+    /*! \brief Queues a task to run after all tasks enqueued before it */
+    void enqueue(std::function<void()> fncTask);
+    /*! \brief Waits until all enqueued tasks have run */
+    void wait();
+  };
+}
+
+
+#endif /* __WORKER_POOL_H__ */
@@ -57,10 +57,10 @@ namespace semrec {
     CExporterDot();
     ~CExporterDot();
     
-    int countNodes(std::list<Node*> lstNodes);
+    int countNodes(const std::vector<Node*>& vecNodes);
     virtual bool runExporter(KeyValuePair* ckvpConfigurationOverlay);
     bool runSequentialExporter();
-    std::string generateDotStringForNodes(std::list<Node*> lstNodes, std::string strParentID, int& nIndex);
+    std::string generateDotStringForNodes(const std::vector<Node*>& vecNodes, std::string strParentID, int& nIndex);
     std::string generateDotImagesStringForNode(Node* ndImages, bool bVisible = true);
     std::string generateDotObjectsStringForNode(Node* ndObjects, bool bVisible = true);
     std::string generateDotStringForDescription(std::list<KeyValuePair*> lstDescription, int nTimeStart = -1, int nTimeEnd = -1);
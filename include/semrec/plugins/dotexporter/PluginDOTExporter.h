@@ -68,6 +68,8 @@ namespace semrec {
     private:
       bool m_bCreateSequentialFiles;
       
+      void exportPlanTree(const ServiceEvent& seServiceEvent);
+      
     public:
       PLUGIN_CLASS();
       ~PLUGIN_CLASS();
@@ -77,8 +79,7 @@ namespace semrec {
       
       virtual Result cycle();
       
-      virtual void consumeEvent(Event evEvent);
-      Event consumeServiceEvent(ServiceEvent seServiceEvent);
+      virtual void consumeEvent(const Event& evEvent);
     };
   }
   
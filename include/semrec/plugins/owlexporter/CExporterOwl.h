@@ -44,18 +44,53 @@
 // System
 #include <string>
 #include <list>
+#include <vector>
 #include <algorithm>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
 
 // LibConfig
 #include <libconfig.h++>
 
 // Private
 #include <semrec/CExporterFileoutput.h>
+#include <semrec/WorkerPool.h>
 #include <semrec/plugins/owlexporter/OwlIndividual.h>
+#include <semrec/plugins/owlexporter/OwlVocabulary.h>
 
 
 namespace semrec {
   class CExporterOwl : public CExporterFileoutput {
+  public:
+    /*! \brief The blocks of individuals in an OWL file, in file order */
+    typedef enum {
+      OB_EVENTS = 0,
+      OB_OBJECTS,
+      OB_HUMANS,
+      OB_IMAGES,
+      OB_DESIGNATORS,
+      OB_FAILURES,
+      OB_TIMEPOINTS,
+      OB_META_DATA,
+      OB_PARAMETER_ANNOTATIONS,
+      OB_COUNT
+    } OwlBlock;
+    
+    /*! \brief Earliest and latest timepoint written so far */
+    typedef struct {
+      std::string strEarliest;
+      std::string strLatest;
+      double dEarliest;
+      double dLatest;
+      bool bTimed;
+    } TimeSpan;
+    
+    /*! \brief Writes the individuals of one kind for a single node */
+    typedef void (CExporterOwl::*NodeIndividualsGenerator)(Node* ndNode, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    
   private:
     std::list< std::pair<std::string, std::string> > m_lstEntities;
     std::list< std::pair<std::string, std::string> > m_lstFailureMapping;
@@ -64,55 +99,130 @@ namespace semrec {
     std::list< std::pair<std::string, std::string> > m_lstAnnotationPurposeMapping;
     std::string m_strPropertyNamespace;
     std::string m_strDefaultAnnotation;
+    std::string m_strNamespaceID;
+    std::string m_strNamespace;
     std::map<std::string, MappedMetaData> m_mapMetaData;
+    /*! \brief Properties added to every individual of this exporter's exports */
+    OwlIndividual::OwlStaticProperties m_ospStatic;
     std::list<std::string> m_lstAnnotatedParameters;
-    std::list<std::string> m_lstExportedObjectIndividuals, m_lstExportedHumanIndividuals;
     std::map<std::string, std::string> m_mapRegisteredOWLNamespaces;
-    std::map<std::string, KeyValuePair*> m_mapDesignators;
+    std::map<std::string, NodeDesignator> m_mapDesignators;
     int m_nThrowAndCatchFailureCounter;
     
+    // Incremental export: individuals of finished subtrees are
+    // spooled while the experiment runs (see spoolClosedNode).
+    bool m_bSpooling;
+    bool m_bIgnoreSpool;
+    std::string m_strSpoolFilename;
+    BufferedFileWriter* m_bfwSpool;
+    OwlVocabulary m_aovSpooled[OB_COUNT];
+    TimeSpan m_tsSpooled;
+    std::unordered_set<Node*> m_setSpooledNodes;
+    std::map<std::string, NodeDesignator> m_mapSpooledDesignators;
+    std::list<std::string> m_lstSpooledAnnotatedParameters;
+    int m_nSpooledThrowAndCatchFailureCounter;
+    std::unordered_map<Node*, std::string> m_mapIndividualIDs;
+    std::mutex m_mtxIndividualIDs;
+    
     void addEntity(std::string strNickname, std::string strNamespace);
+    void assignIndividualIDs(const std::vector<Node*>& vecNodes);
+    bool nodeSpooled(Node* ndNode);
+    bool nodeAndAncestorsHaveValidDetailLevel(Node* ndNode);
+    bool useSpool();
+    void widenTimeSpan(TimeSpan& tsSpan, std::string strTimepoint);
+    unsigned int exportThreads();
+    /*! \brief Calls nigGenerate for the nodes in vecNodes that weren't spooled, and (if bRecursive) their sub-nodes, in pre-order */
+    void generateIndividualsForNodes(const std::vector<Node*>& vecNodes, NodeIndividualsGenerator nigGenerate, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive);
+    void generateOwlBlocks(const std::vector<OwlBlock>& vecBlocks, std::string strNamespaceID, const std::vector<OutputSink*>& vecBlockSinks, std::vector<OwlVocabulary>& vecVocabularies);
     
   public:
     CExporterOwl();
     ~CExporterOwl();
     
-    std::list<std::string> gatherClassesForNodes(std::list<Node*> lstNodes);
-    std::list<std::string> gatherTimepointsForNodes(std::list<Node*> lstNodes, std::list<Node*> lstTrace);
+    std::list<std::string> gatherClassesForNodes(const std::vector<Node*>& vecNodes);
+    void gatherTimepointsForNodes(const std::vector<Node*>& vecNodes, std::vector<std::string>& vecTimepoints, bool bRecursive = true);
+    void gatherDesignatorTimepoints(std::vector<std::string>& vecTimepoints);
     void setMetaData(std::map<std::string, MappedMetaData> mapMetaData);
     
     bool loadSemanticsDescriptorFile(std::string strFilepath);
     
     void prepareEntities(std::string strNamespaceID, std::string strNamespace);
-    std::string generateDocTypeBlock();
-    std::string generateXMLNSBlock(std::string strNamespace);
-    std::string generateOwlImports(std::string strNamespace);
-    std::string generatePropertyDefinitions();
-    std::string generateClassDefinitions();
-    std::string generateEventIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace);
-    std::string generateEventIndividuals(std::string strNamespace);
-    std::string generateObjectIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace);
-    std::string generateObjectIndividuals(std::string strNamespace);
-    std::string generateHumanIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace);
-    std::string generateHumanIndividuals(std::string strNamespace);
-    std::string generateImageIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace);
-    std::string generateImageIndividuals(std::string strNamespace);
-    std::string generateDesignatorIndividuals(std::string strNamespace);
+    void generateDocTypeBlock(OutputSink& osOwl);
+    void generateXMLNSBlock(std::string strNamespace, OutputSink& osOwl);
+    void generateOwlImports(std::string strNamespace, OutputSink& osOwl);
+    void generatePropertyDefinitions(const OwlVocabulary& ovIssued, OutputSink& osOwl);
+    void generateClassDefinitions(const OwlVocabulary& ovIssued, OutputSink& osOwl);
+    void generateEventIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive = true);
+    void generateEventIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateObjectIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive = true);
+    void generateObjectIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateObjectIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateHumanIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive = true);
+    void generateHumanIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateHumanIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateImageIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive = true);
+    void generateImageIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateImageIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateDesignatorIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
     std::list<std::string> collectAllSuccessorDesignatorIDs(std::string strDesigID);
-    std::string generateFailureIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace);
-    std::string generateFailureIndividuals(std::string strNamespace);
-    std::string generateTimepointIndividuals(std::string strNamespace);
-    std::string generateMetaDataIndividual(std::string strNamespace);
-    std::string generateParameterAnnotationInformation(std::string strNamespace);
+    void generateFailureIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive = true);
+    void generateFailureIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateFailureIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateTimepointIndividualsFor(const std::vector<std::string>& vecTimepoints, TimeSpan& tsSpan, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateTimepointIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateMetaDataIndividual(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
+    void generateParameterAnnotationInformation(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued);
     
     std::string owlClassForNode(Node *ndNode, bool bClassOnly = false, bool bPrologSyntax = false);
+    /*! \brief The ID of the individual that represents ndNode
+      
+      While spooling, nodes keep the ID they got when they were first
+      written, across exports; otherwise this is the node's unique
+      ID. */
+    std::string individualIDForNode(Node* ndNode);
     std::string owlClassForObject(KeyValuePair *ckvpObject);  
     std::string owlClassForHuman(KeyValuePair *ckvpObject);  
     virtual std::string nodeIDPrefix(Node* ndInQuestion, std::string strProposition);
     
     virtual bool runExporter(KeyValuePair* ckvpConfigurationOverlay);
     std::string owlEscapeString(std::string strValue);
-    std::string generateOwlStringForNodes(std::list<Node*> lstNodes, std::string strNamespaceID, std::string strNamespace);
+    void generateOwlHead(std::string strNamespace, const OwlVocabulary& ovIssued, OutputSink& osOwl);
+    void generateOwlBlock(OwlBlock obBlock, std::string strNamespaceID, OutputSink* osOwl, OwlVocabulary* ovIssued);
+    /*! \brief Generates all blocks of individuals, one sink per block
+      
+      vecBlockSinks holds one sink for every OwlBlock. Blocks that do
+      not depend on each other are generated concurrently; ovIssued
+      receives the vocabulary of all blocks in file order. */
+    void generateOwlBody(std::string strNamespaceID, const std::vector<OutputSink*>& vecBlockSinks, OwlVocabulary& ovIssued);
+    bool writeOwlFile(std::string strFilename, std::string strNamespaceID, std::string strNamespace);
+    
+    /*! \brief Starts writing individuals incrementally into strSpoolFilename
+      
+      From then on, spoolClosedNode() writes the individuals of all
+      sub-nodes of every finalized node, together with their
+      objects, humans, images, failures and timepoints. Exports skip
+      the spooled node individuals and splice in the spool file. They
+      still generate the open nodes, root nodes and meta data, and
+      the individuals and timepoints of all designators of the
+      experiment (spooled or not, as they are not spooled); the
+      `symbolic-plan-tree' response also copies the whole designator
+      registry. So an export takes time proportional to the open part
+      of the tree plus the number of designators. The display settings
+      must not depend on node success while spooling, as the success
+      of open ancestors is not known yet. */
+    bool startSpool(std::string strSpoolFilename);
+    /*! \brief Stops spooling and removes the spool file */
+    void stopSpool();
+    bool spooling();
+    /*! \brief Makes exports generate everything from scratch while spooling
+      
+      The spool is neither used nor touched, but nodes keep their
+      spooled IDs, so the result can be compared with an incremental
+      export of the same tree (see scripts/owl-incremental-check.py). */
+    void setIgnoreSpool(bool bIgnoreSpool);
+    void spoolClosedNode(Node* ndClosed);
+    
+    std::string generateOwlStringForNodes(const std::vector<Node*>& vecNodes, std::string strNamespaceID, std::string strNamespace);
     
     std::string failureClassForCondition(std::string strCondition);
     std::string resolveDesignatorAnnotationTagName(std::string strAnnotation);
@@ -48,6 +48,10 @@
 #include <iostream>
 #include <map>
 
+// Private
+#include <semrec/OutputSink.h>
+#include <semrec/plugins/owlexporter/OwlVocabulary.h>
+
 
 namespace semrec {
   class OwlIndividual {
@@ -59,25 +63,32 @@ namespace semrec {
       std::string strContent;
     } OwlProperty;
     
-  private:
-    static std::map<std::string, std::string> s_mapStaticResources;
-    static std::map<std::string, std::string> s_mapStaticProperties;
+    /*! \brief Properties every individual of one export carries
+      
+      Owned by the exporter, and only read while individuals are
+      printed (possibly from several threads). */
+    typedef struct _OwlStaticProperties {
+      std::map<std::string, std::string> mapResources;
+      std::map<std::string, std::string> mapProperties;
+    } OwlStaticProperties;
     
+  private:
     std::list<OwlProperty> m_lstProperties;
     std::string m_strID;
     std::string m_strType;
-    
-    static std::list<std::string> m_lstIssuedProperties;
-    static std::list<std::string> m_lstIssuedTypes;
+    OwlVocabulary* m_ovIssued;
+    const OwlStaticProperties* m_ospStatic;
     
   protected:
   public:
     OwlIndividual();
+    /*! \brief Records the type and properties set on this individual into ovIssued
+      
+      If given, the properties in ospStatic are printed along with
+      the individual's own. */
+    OwlIndividual(OwlVocabulary& ovIssued, const OwlStaticProperties* ospStatic = NULL);
     ~OwlIndividual();
     
-    static void addStaticResource(std::string strKey, std::string strResource);
-    static void addStaticProperty(std::string strKey, std::string strProperty);
-    
     void setID(std::string strID);
     void setType(std::string strType);
     
@@ -89,15 +100,10 @@ namespace semrec {
     void issueType(std::string strType);
     
     std::string indent(int nSpaces);
+    void writeIndent(OutputSink& osOut, int nSpaces);
     
+    void print(OutputSink& osOut, int nIndentation = 1, int nIndentationPerLevel = 4);
     std::string print(int nIndentation = 1, int nIndentationPerLevel = 4);
-    
-    static void resetIssuedProperties();
-    static void resetIssuedTypes();
-    static void resetIssuedInformation();
-    
-    static std::list<std::string> issuedProperties();
-    static std::list<std::string> issuedTypes();
   };
 }
 
@@ -0,0 +1,97 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#ifndef __OWL_VOCABULARY_H__
+#define __OWL_VOCABULARY_H__
+
+
+// System
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <mutex>
+
+
+namespace semrec {
+  /*! \brief Types, properties and shared individuals of one OWL export
+    
+    The property and class definitions at the top of an OWL file are
+    generated from this. Entries are kept in insertion order, so the
+    definitions come out deterministically, and are hashed, so
+    issuing stays constant time for large exports. All members are
+    safe to call concurrently. Every block of individuals records
+    into its own vocabulary; merging them in block order yields the
+    same definitions as a sequential export. */
+  class OwlVocabulary {
+  private:
+    std::vector<std::string> m_vecIssuedProperties;
+    std::unordered_set<std::string> m_setIssuedProperties;
+    std::vector<std::string> m_vecIssuedTypes;
+    std::unordered_set<std::string> m_setIssuedTypes;
+    std::unordered_set<std::string> m_setIssuedIndividuals;
+    mutable std::mutex m_mtxAccess;
+    
+    static bool issue(std::string strEntry, std::vector<std::string>& vecEntries, std::unordered_set<std::string>& setEntries);
+    
+  public:
+    OwlVocabulary();
+    ~OwlVocabulary();
+    
+    OwlVocabulary(const OwlVocabulary&) = delete;
+    OwlVocabulary& operator=(const OwlVocabulary&) = delete;
+    
+    /*! \brief Returns true if strProperty was not issued before */
+    bool issueProperty(std::string strProperty);
+    /*! \brief Returns true if strType was not issued before */
+    bool issueType(std::string strType);
+    /*! \brief Returns true if the individual strID was not exported before
+      
+      Used for individuals that many nodes refer to (objects, humans),
+      so they get written only once. */
+    bool issueIndividual(std::string strID);
+    
+    /*! \brief Appends all entries of ovOther not known yet, in their order */
+    void merge(const OwlVocabulary& ovOther);
+    void clear();
+    
+    std::vector<std::string> issuedProperties() const;
+    std::vector<std::string> issuedTypes() const;
+  };
+}
+
+
+#endif /* __OWL_VOCABULARY_H__ */
@@ -47,6 +47,7 @@
 // System
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 
 // ROS
 #include <ros/ros.h>
@@ -59,6 +60,7 @@
 #include <semrec/Types.h>
 #include <semrec/ForwardDeclarations.h>
 #include <semrec/Plugin.h>
+#include <semrec/NodeArena.h>
 #include <semrec/plugins/owlexporter/CExporterOwl.h>
 
 
@@ -68,6 +70,16 @@ namespace semrec {
     private:
       std::map<std::string, MappedMetaData> m_mapMetaData;
       std::map<std::string, std::string> m_mapRegisteredOWLNamespaces;
+      bool m_bIncremental;
+      bool m_bIncrementalVerify;
+      int m_nIncrementalMaxDetailLevel;
+      CExporterOwl* m_expSpool;
+      std::mutex m_mtxSpool;
+      
+      CExporterOwl* createExporter(int nShowSuccesses, int nShowFails, int nMaxDetailLevel);
+      void spoolClosedNode(Node* ndClosed);
+      void discardSpool();
+      void exportPlanTree(const ServiceEvent& seServiceEvent);
       
     public:
       PLUGIN_CLASS();
@@ -78,8 +90,7 @@ namespace semrec {
       
       virtual Result cycle();
       
-      virtual void consumeEvent(Event evEvent);
-      Event consumeServiceEvent(ServiceEvent seServiceEvent);
+      virtual void consumeEvent(const Event& evEvent);
     };
   }
   
@@ -106,8 +106,8 @@ namespace semrec {
       
       virtual Result cycle();
       
-      virtual Event consumeServiceEvent(ServiceEvent seEvent);
-      virtual void consumeEvent(Event evEvent);
+      virtual Event consumeServiceEvent(const ServiceEvent& seEvent);
+      virtual void consumeEvent(const Event& evEvent);
       
       bool serviceCallbackLoad(designator_integration_msgs::DesignatorCommunication::Request &req, designator_integration_msgs::DesignatorCommunication::Response &res);
       
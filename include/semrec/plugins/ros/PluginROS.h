@@ -48,6 +48,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <algorithm>
+#include <unordered_map>
 
 // Boost
 #include <boost/thread.hpp>
@@ -66,11 +67,12 @@
 #include <semrec/Types.h>
 #include <semrec/ForwardDeclarations.h>
 #include <semrec/Plugin.h>
+#include <semrec/MessageSink.h>
 
 
 namespace semrec {
   namespace plugins {
-    class PLUGIN_CLASS : public Plugin {
+    class PLUGIN_CLASS : public Plugin, public StatusMessageConsumer {
     private:
       ros::NodeHandle* m_nhHandle;
       ros::ServiceServer m_srvCallback;
@@ -106,8 +108,9 @@ namespace semrec {
       
       bool serviceCallback(designator_integration_msgs::DesignatorCommunication::Request &req, designator_integration_msgs::DesignatorCommunication::Response &res);
       
-      virtual void consumeEvent(Event evEvent);
-      virtual Event consumeServiceEvent(ServiceEvent seServiceEvent);
+      virtual void consumeEvent(const Event& evEvent);
+      virtual Event consumeServiceEvent(const ServiceEvent& seServiceEvent);
+      virtual void consumeStatusMessages(const std::vector<StatusMessage>& vecMessages);
       
       std::string getDesignatorTypeString(Designator* desigDesignator);
       
@@ -47,6 +47,8 @@
 // System
 #include <cstdlib>
 #include <iostream>
+#include <unordered_set>
+#include <unordered_map>
 
 // ROS
 #include <ros/ros.h>
@@ -60,22 +62,46 @@
 #include <semrec/ForwardDeclarations.h>
 #include <semrec/Plugin.h>
 #include <semrec/Node.h>
+#include <semrec/NodeArena.h>
+#include <semrec/UniqueIDGenerator.h>
 
 
 namespace semrec {
   namespace plugins {
     class PLUGIN_CLASS : public Plugin {
     private:
+      /*! \brief Owns the current experiment's nodes
+	
+	Replaced (and the old one retired) when a new experiment
+	starts, as events still in flight may refer to its nodes. */
+      std::shared_ptr<NodeArena> m_naNodes;
+      /*! \brief Carried by `symbolic-finalize-context' events, refers to m_naNodes */
+      std::shared_ptr<const PlanTreeData> m_ptdFinalizeData;
+      std::list<Node*> m_lstNodesWithoutTimeEnd;
+      UniqueIDGenerator m_uigDesignatorIDs;
       std::list<Node*> m_lstNodes;
       std::list<Node*> m_lstRootNodes;
       Node* m_ndActive;
       std::list<Node*> m_lstNodeStack;
-      std::list< std::pair<std::string, std::string> > m_lstDesignatorIDs;
-      std::list< std::pair<std::string, std::string> > m_lstDesignatorEquations;
-      std::list< std::pair<std::string, std::string> > m_lstDesignatorEquationTimes;
+      DesignatorRegistry m_drDesignators;
       std::pair<std::string, Node*> m_prLastFailure;
       std::map<std::string, Node*> m_mapFailureCatchers;
       std::map<int, Node*> m_mapNodeIDs;
+      std::unordered_set<Node*> m_setEndedNodes;
+      std::unordered_set<Node*> m_setFinalizedNodes;
+      std::unordered_map<Node*, unsigned int> m_mapFinalizedSubnodes;
+      
+      /*! \brief Records that a context received its actual end
+          (prematurely stopped contexts do not count until they are
+          stopped themselves) and finalizes what became complete. */
+      void markNodeEnded(Node* ndEnded);
+      /*! \brief Announces 'symbolic-finalize-context' for ndFrom and
+          its ancestors, as long as they ended, all their subnodes are
+          finalized, and the active context is not inside them. From
+          then on, nothing below or at the node changes anymore. */
+      void finalizeCompletedNodes(Node* ndFrom);
+      /*! \brief Retires the current node arena and starts a new one */
+      void renewNodeArena();
       
     public:
       PLUGIN_CLASS();
@@ -86,17 +112,17 @@ namespace semrec {
       
       virtual Result cycle();
       
-      virtual void consumeEvent(Event evEvent);
-      virtual Event consumeServiceEvent(ServiceEvent seServiceEvent);
+      virtual void consumeEvent(const Event& evEvent);
+      virtual Event consumeServiceEvent(const ServiceEvent& seServiceEvent);
       
       Node* addNode(std::string strName, int nContextID, Node* ndParent = NULL);
+      void ensureTimeEnd(Node* ndRoot, double dTimeEnd, std::string strTimeEnd);
       void setNodeAsActive(Node* ndActive);
       Node* activeNode();
       
       std::string getDesignatorID(std::string strMemoryAddress);
       std::string getDesignatorIDType(Designator* desigCurrent);
       std::string getUniqueDesignatorID(std::string strMemoryAddress, Designator* desigCurrent);
-      std::string generateRandomIdentifier(std::string strPrefix, unsigned int unLength);
       std::string equateDesignators(std::string strMAChild, Designator* desigChild, std::string strMAParent, Designator* desigParent);
       
       bool ensureDesignatorPublished(std::list<KeyValuePair*> lstDescription, std::string strMemoryAddress, std::string strType, std::string strAnnotation = "", bool bAdd = false, Node* ndRelative = NULL);
@@ -0,0 +1,90 @@
+#!/usr/bin/python
+
+# Compares an incremental OWL export with the batch export of the same
+# tree (as written by the owlexporter plugin when `incremental-verify'
+# is enabled). Both files must define the same classes, properties and
+# individuals; only the order and the IDs of the per-export meta data
+# individuals may differ.
+
+import re
+import sys
+from xml.dom.minidom import parse
+
+params_ok = True
+
+if len(sys.argv) < 3 or sys.argv[1] == "" or sys.argv[2] == "":
+    print("Usage: " + sys.argv[0] + " <incremental.owl> <incremental.owl.batch>")
+    print("")
+    print("Use logs that contain contexts stopped while a sub-context was")
+    print("active (premature stops) and contexts stopped with a")
+    print("`_relative_context_id', as these finish out of order.")
+    params_ok = False
+
+# IDs that are drawn anew for every export
+volatile_ids = re.compile("(RobotExperiment_|AnnotationInformation_)[0-9A-Za-z]+")
+
+def canonical(node):
+    if node.nodeType == node.TEXT_NODE:
+        return volatile_ids.sub("\\1*", node.data.strip())
+
+    if node.nodeType != node.ELEMENT_NODE:
+        return ""
+
+    attributes = []
+    for index in range(node.attributes.length):
+        attribute = node.attributes.item(index)
+        attributes.append(attribute.name + "=" + volatile_ids.sub("\\1*", attribute.value))
+
+    children = []
+    for child in node.childNodes:
+        child_canonical = canonical(child)
+        if child_canonical != "":
+            children.append(child_canonical)
+
+    return "<" + node.tagName + " " + " ".join(sorted(attributes)) + ">" + "".join(sorted(children)) + "</" + node.tagName + ">"
+
+def definitions(file_owl):
+    dom_owl = parse(file_owl)
+    root = dom_owl.documentElement
+    result = []
+
+    for child in root.childNodes:
+        if child.nodeType == child.ELEMENT_NODE:
+            result.append(canonical(child))
+
+    return sorted(result)
+
+if params_ok:
+    incremental = definitions(sys.argv[1])
+    batch = definitions(sys.argv[2])
+
+    # Multiset difference in both directions
+    only_incremental = []
+    only_batch = []
+    index_incremental = 0
+    index_batch = 0
+
+    while index_incremental < len(incremental) or index_batch < len(batch):
+        if index_batch == len(batch) or (index_incremental < len(incremental) and incremental[index_incremental] < batch[index_batch]):
+            only_incremental.append(incremental[index_incremental])
+            index_incremental += 1
+        elif index_incremental == len(incremental) or batch[index_batch] < incremental[index_incremental]:
+            only_batch.append(batch[index_batch])
+            index_batch += 1
+        else:
+            index_incremental += 1
+            index_batch += 1
+
+    print("Definitions: " + str(len(incremental)) + " incremental, " + str(len(batch)) + " batch")
+
+    for definition in only_incremental:
+        print("Only in incremental export: " + definition)
+
+    for definition in only_batch:
+        print("Only in batch export: " + definition)
+
+    if len(only_incremental) > 0 or len(only_batch) > 0:
+        print("Exports differ (" + str(len(only_incremental)) + " / " + str(len(only_batch)) + " definitions)")
+        sys.exit(1)
+    else:
+        print("Exports are equivalent")
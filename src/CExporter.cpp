@@ -43,6 +43,7 @@
 namespace semrec {
   CExporter::CExporter() {
     m_ckvpConfiguration = new KeyValuePair();
+    m_drDesignators = std::make_shared<DesignatorRegistry>();
   }
 
   CExporter::~CExporter() {
@@ -62,7 +63,11 @@ namespace semrec {
   }
 
   void CExporter::addNode(Node* ndAdd) {
-    m_lstNodes.push_back(ndAdd);
+    m_vecNodes.push_back(ndAdd);
+  }
+  
+  void CExporter::setNodes(const std::list<Node*>& lstNodes) {
+    m_vecNodes.assign(lstNodes.begin(), lstNodes.end());
   }
   
   void CExporter::setRootNodes(std::list<Node*> lstRootNodes) {
@@ -77,16 +82,16 @@ namespace semrec {
     return m_lstRootNodes;
   }
   
-  std::list<Node*> CExporter::nodes() {
-    return m_lstNodes;
+  const std::vector<Node*>& CExporter::nodes() {
+    return m_vecNodes;
   }
 
   void CExporter::clearNodes() {
-    for(Node* ndDelete : m_lstNodes) {
+    for(Node* ndDelete : m_vecNodes) {
       delete ndDelete;
     }
     
-    m_lstNodes.clear();
+    m_vecNodes.clear();
   }
   
   KeyValuePair* CExporter::configuration() {
@@ -94,7 +99,7 @@ namespace semrec {
   }
   
   std::string CExporter::nodeIDPrefix(Node* ndInQuestion, std::string strProposition) {
-    std::string strPrefix = ndInQuestion->metaInformation()->stringValue("class");
+    std::string strPrefix = ndInQuestion->className();
     
     if(strPrefix == "") {
       strPrefix = strProposition;
@@ -105,19 +110,22 @@ namespace semrec {
     return strPrefix;
   }
   
-  void CExporter::renewUniqueIDsForNode(Node *ndRenew) {
-    std::string strNodeIDPrefix = this->nodeIDPrefix(ndRenew, "node_");
-    ndRenew->setUniqueID(this->generateUniqueID(strNodeIDPrefix));
-    
-    std::list<Node*> lstSubnodes = ndRenew->subnodes();
-    for(Node* ndNode : lstSubnodes) {
-      this->renewUniqueIDsForNode(ndNode);
-    }
-  }
-  
   void CExporter::renewUniqueIDs() {
-    for(Node* ndNode : m_lstNodes) {
-      this->renewUniqueIDsForNode(ndNode);
+    class UniqueIDVisitor : public NodeVisitor {
+    public:
+      CExporter* m_expIssuer;
+      
+      bool enterNode(Node* ndNode) {
+	ndNode->setUniqueID(m_expIssuer->generateUniqueID(m_expIssuer->nodeIDPrefix(ndNode, "node_")));
+	
+	return true;
+      }
+    } uivVisitor;
+    
+    uivVisitor.m_expIssuer = this;
+    
+    for(Node* ndNode : m_vecNodes) {
+      ndNode->accept(uivVisitor);
     }
   }
   
@@ -151,17 +159,14 @@ namespace semrec {
   }
   
   std::string CExporter::generateUniqueID(std::string strPrefix, unsigned int unLength) {
-    std::string strID;
-    
-    do {
-      strID = this->generateRandomIdentifier(strPrefix, unLength);
-    } while(this->uniqueIDPresent(strID));
-  
-    return strID;
+    // NOTE: IDs from the generator are unique by
+    // construction, so they don't need to be checked against the
+    // node tree (which made renewing all IDs quadratic).
+    return m_uigIDs.uniqueID(strPrefix, unLength);
   }
 
   bool CExporter::uniqueIDPresent(std::string strUniqueID) {
-    for(Node* ndNode : m_lstNodes) {
+    for(Node* ndNode : m_vecNodes) {
       if(ndNode->includesUniqueID(strUniqueID)) {
 	return true;
       }
@@ -184,7 +189,7 @@ namespace semrec {
   
   bool CExporter::nodeHasValidDetailLevel(Node* ndDisplay) {
     int nConfigMaxDetailLevel = this->configuration()->floatValue("max-detail-level");
-    int nNodeDetailLevel = ndDisplay->metaInformation()->floatValue("detail-level");
+    int nNodeDetailLevel = ndDisplay->detailLevel();
     
     return (nNodeDetailLevel <= nConfigMaxDetailLevel);
   }
@@ -192,7 +197,7 @@ namespace semrec {
   bool CExporter::nodeDisplayable(Node* ndDisplay) {
     bool bDisplaySuccesses = (this->configuration()->floatValue("display-successes") == 1);
     bool bDisplayFailures = (this->configuration()->floatValue("display-failures") == 1);
-    bool bNodeSuccess = (ndDisplay->metaInformation()->floatValue("success") == 1);
+    bool bNodeSuccess = ndDisplay->success();
     
     if(this->nodeHasValidDetailLevel(ndDisplay)) {
       if((bNodeSuccess && bDisplaySuccesses) || (!bNodeSuccess && bDisplayFailures)) {
@@ -203,62 +208,31 @@ namespace semrec {
     return false;
   }
 
-  void CExporter::setDesignatorIDs(std::list< std::pair<std::string, std::string> > lstDesignatorIDs) {
-    m_lstDesignatorIDs = lstDesignatorIDs;
-  }
-
-  void CExporter::setDesignatorEquations(std::list< std::pair<std::string, std::string> > lstDesignatorEquations) {
-    m_lstDesignatorEquations = lstDesignatorEquations;
+  void CExporter::setDesignatorRegistry(std::shared_ptr<const DesignatorRegistry> drDesignators) {
+    if(drDesignators) {
+      m_drDesignators = drDesignators;
+    } else {
+      m_drDesignators = std::make_shared<DesignatorRegistry>();
+    }
   }
   
-  void CExporter::setDesignatorEquationTimes(std::list< std::pair<std::string, std::string> > lstDesignatorEquationTimes) {
-    m_lstDesignatorEquationTimes = lstDesignatorEquationTimes;
+  const DesignatorRegistry& CExporter::designatorRegistry() {
+    return *m_drDesignators;
   }
   
-  std::list<std::string> CExporter::designatorIDs() {
-    std::list<std::string> lstResult;
-    
-    for(std::pair<std::string, std::string> prPair : m_lstDesignatorIDs) {
-      lstResult.push_back(prPair.second);
-    }
-    
-    return lstResult;
+  const std::vector<std::string>& CExporter::designatorIDs() {
+    return m_drDesignators->designatorIDs();
   }
   
   std::list<std::string> CExporter::parentDesignatorsForID(std::string strID) {
-    std::list<std::string> lstResult;
-    
-    for(std::pair<std::string, std::string> prPair : m_lstDesignatorEquations) {
-      if(prPair.second == strID) {
-	lstResult.push_back(prPair.first);
-      }
-    }
-    
-    return lstResult;
+    return m_drDesignators->parentIDs(strID);
   }
   
   std::list<std::string> CExporter::successorDesignatorsForID(std::string strID) {
-    std::list<std::string> lstResult;
-    
-    for(std::pair<std::string, std::string> prPair : m_lstDesignatorEquations) {
-      if(prPair.first == strID) {
-	lstResult.push_back(prPair.second);
-      }
-    }
-    
-    return lstResult;
+    return m_drDesignators->successorIDs(strID);
   }
   
   std::string CExporter::equationTimeForSuccessorID(std::string strID) {
-    std::string strReturn = "";
-    
-    for(std::pair<std::string, std::string> prPair : m_lstDesignatorEquationTimes) {
-      if(prPair.first == strID) {
-	strReturn = prPair.second;
-	break;
-      }
-    }
-    
-    return strReturn;
+    return m_drDesignators->equationTime(strID);
   }
 }
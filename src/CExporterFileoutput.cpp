@@ -56,18 +56,19 @@ namespace semrec {
     return this->configuration()->stringValue("filename");
   }
   
-  bool CExporterFileoutput::writeToFile(std::string strContent, std::string strFilename) {
+  bool CExporterFileoutput::writeToFile(const std::string& strContent, std::string strFilename) {
     if(strFilename == "") {
       strFilename = this->configuration()->stringValue("filename");
     }
     
     if(strFilename != "") {
-      std::ofstream fsFile;
-      fsFile.open(strFilename.c_str());
-      fsFile << strContent;
-      fsFile.close();
+      BufferedFileWriter bfwFile;
       
-      return true;
+      if(bfwFile.open(strFilename)) {
+	bfwFile.write(strContent);
+	
+	return bfwFile.close();
+      }
     }
     
     return false;
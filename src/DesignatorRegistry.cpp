@@ -0,0 +1,358 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <semrec/DesignatorRegistry.h>
+
+
+namespace semrec {
+  DesignatorRegistry::DesignatorRegistry() {
+    m_unVisitStamp = 0;
+  }
+  
+  DesignatorRegistry::DesignatorRegistry(const DesignatorRegistry& drCopy) {
+    m_unVisitStamp = 0;
+    *this = drCopy;
+  }
+  
+  DesignatorRegistry::~DesignatorRegistry() {
+  }
+  
+  DesignatorRegistry& DesignatorRegistry::operator=(const DesignatorRegistry& drCopy) {
+    if(this != &drCopy) {
+      m_vecRecords = drCopy.m_vecRecords;
+      m_mapRecordIndices = drCopy.m_mapRecordIndices;
+      m_mapIDsByMemoryAddress = drCopy.m_mapIDsByMemoryAddress;
+      m_vecIDs = drCopy.m_vecIDs;
+      m_vecEquations = drCopy.m_vecEquations;
+      
+      // Copies are made for exports (one per `symbolic-plan-tree'
+      // request), which ask for the closures themselves; the
+      // registry they are copied from never does.
+      m_mtxSuccessorClosures.lock();
+      m_mapSuccessorClosures.clear();
+      m_mtxSuccessorClosures.unlock();
+    }
+    
+    return *this;
+  }
+  
+  void DesignatorRegistry::clear() {
+    m_vecRecords.clear();
+    m_mapRecordIndices.clear();
+    m_mapIDsByMemoryAddress.clear();
+    m_vecIDs.clear();
+    m_vecEquations.clear();
+    
+    m_mtxSuccessorClosures.lock();
+    m_mapSuccessorClosures.clear();
+    m_vecVisitStamps.clear();
+    m_unVisitStamp = 0;
+    m_mtxSuccessorClosures.unlock();
+  }
+  
+  unsigned int DesignatorRegistry::recordIndex(std::string strID) {
+    std::unordered_map<std::string, unsigned int>::iterator itIndex = m_mapRecordIndices.find(strID);
+    
+    if(itIndex != m_mapRecordIndices.end()) {
+      return itIndex->second;
+    }
+    
+    unsigned int unIndex = m_vecRecords.size();
+    
+    DesignatorRecord drNew;
+    drNew.strID = strID;
+    drNew.unClass = unIndex;
+    drNew.vecClassMembers.push_back(unIndex);
+    
+    m_vecRecords.push_back(drNew);
+    m_mapRecordIndices[strID] = unIndex;
+    
+    return unIndex;
+  }
+  
+  const DesignatorRegistry::DesignatorRecord* DesignatorRegistry::record(std::string strID) const {
+    std::unordered_map<std::string, unsigned int>::const_iterator itIndex = m_mapRecordIndices.find(strID);
+    
+    if(itIndex != m_mapRecordIndices.end()) {
+      return &m_vecRecords[itIndex->second];
+    }
+    
+    return NULL;
+  }
+  
+  unsigned int DesignatorRegistry::classOf(unsigned int unRecord) const {
+    // NOTE: unite() points every member of a merged class
+    // directly at its representative, so this takes at most one
+    // step and never has to write (the OWL exporter reads a
+    // snapshot from several block threads at once).
+    while(m_vecRecords[unRecord].unClass != unRecord) {
+      unRecord = m_vecRecords[unRecord].unClass;
+    }
+    
+    return unRecord;
+  }
+  
+  void DesignatorRegistry::unite(unsigned int unRecordA, unsigned int unRecordB) {
+    unsigned int unClassA = this->classOf(unRecordA);
+    unsigned int unClassB = this->classOf(unRecordB);
+    
+    if(unClassA != unClassB) {
+      if(m_vecRecords[unClassA].vecClassMembers.size() < m_vecRecords[unClassB].vecClassMembers.size()) {
+	std::swap(unClassA, unClassB);
+      }
+      
+      DesignatorRecord& drInto = m_vecRecords[unClassA];
+      DesignatorRecord& drFrom = m_vecRecords[unClassB];
+      
+      // Point all members of the smaller class directly at the new
+      // representative.
+      for(unsigned int unMember : drFrom.vecClassMembers) {
+	m_vecRecords[unMember].unClass = unClassA;
+	drInto.vecClassMembers.push_back(unMember);
+      }
+      
+      drFrom.vecClassMembers.clear();
+    }
+  }
+  
+  void DesignatorRegistry::beginWalk() const {
+    if(m_vecVisitStamps.size() < m_vecRecords.size()) {
+      m_vecVisitStamps.resize(m_vecRecords.size(), 0);
+    }
+    
+    m_unVisitStamp++;
+    
+    if(m_unVisitStamp == 0) {
+      // Wrapped around; old stamps could be mistaken for new ones.
+      std::fill(m_vecVisitStamps.begin(), m_vecVisitStamps.end(), 0);
+      m_unVisitStamp = 1;
+    }
+  }
+  
+  bool DesignatorRegistry::visit(unsigned int unRecord) const {
+    if(m_vecVisitStamps[unRecord] == m_unVisitStamp) {
+      return false;
+    }
+    
+    m_vecVisitStamps[unRecord] = m_unVisitStamp;
+    
+    return true;
+  }
+  
+  void DesignatorRegistry::invalidateClosuresReaching(unsigned int unRecord) {
+    m_mtxSuccessorClosures.lock();
+    
+    if(!m_mapSuccessorClosures.empty()) {
+      // The closures that change are the ones of unRecord and of
+      // everything it is reachable from.
+      std::vector<unsigned int> vecPending;
+      
+      this->beginWalk();
+      this->visit(unRecord);
+      vecPending.push_back(unRecord);
+      
+      while(!vecPending.empty()) {
+	unsigned int unCurrent = vecPending.back();
+	vecPending.pop_back();
+	
+	m_mapSuccessorClosures.erase(unCurrent);
+	
+	for(unsigned int unParent : m_vecRecords[unCurrent].vecParents) {
+	  if(this->visit(unParent)) {
+	    vecPending.push_back(unParent);
+	  }
+	}
+      }
+    }
+    
+    m_mtxSuccessorClosures.unlock();
+  }
+  
+  void DesignatorRegistry::registerDesignator(std::string strMemoryAddress, std::string strID) {
+    if(m_mapIDsByMemoryAddress.find(strMemoryAddress) == m_mapIDsByMemoryAddress.end()) {
+      m_mapIDsByMemoryAddress[strMemoryAddress] = strID;
+      m_vecRecords[this->recordIndex(strID)].strMemoryAddress = strMemoryAddress;
+      m_vecIDs.push_back(strID);
+    }
+  }
+  
+  std::string DesignatorRegistry::idForMemoryAddress(std::string strMemoryAddress) const {
+    std::unordered_map<std::string, std::string>::const_iterator itID = m_mapIDsByMemoryAddress.find(strMemoryAddress);
+    
+    if(itID != m_mapIDsByMemoryAddress.end()) {
+      return itID->second;
+    }
+    
+    return "";
+  }
+  
+  void DesignatorRegistry::addEquation(std::string strParentID, std::string strChildID, std::string strTime) {
+    unsigned int unParent = this->recordIndex(strParentID);
+    unsigned int unChild = this->recordIndex(strChildID);
+    
+    m_vecRecords[unParent].vecSuccessors.push_back(unChild);
+    m_vecRecords[unChild].vecParents.push_back(unParent);
+    
+    if(m_vecRecords[unChild].strEquationTime == "") {
+      m_vecRecords[unChild].strEquationTime = strTime;
+    }
+    
+    this->unite(unParent, unChild);
+    m_vecEquations.push_back({strParentID, strChildID, strTime});
+    
+    // The new edge changes the closures of the parent and its
+    // ancestors only.
+    this->invalidateClosuresReaching(unParent);
+  }
+  
+  const std::vector<std::string>& DesignatorRegistry::designatorIDs() const {
+    return m_vecIDs;
+  }
+  
+  const std::vector<DesignatorEquation>& DesignatorRegistry::equations() const {
+    return m_vecEquations;
+  }
+  
+  std::list<std::string> DesignatorRegistry::parentIDs(std::string strID) const {
+    std::list<std::string> lstIDs;
+    const DesignatorRecord* drRecord = this->record(strID);
+    
+    if(drRecord) {
+      for(unsigned int unParent : drRecord->vecParents) {
+	lstIDs.push_back(m_vecRecords[unParent].strID);
+      }
+    }
+    
+    return lstIDs;
+  }
+  
+  std::list<std::string> DesignatorRegistry::successorIDs(std::string strID) const {
+    std::list<std::string> lstIDs;
+    const DesignatorRecord* drRecord = this->record(strID);
+    
+    if(drRecord) {
+      for(unsigned int unSuccessor : drRecord->vecSuccessors) {
+	lstIDs.push_back(m_vecRecords[unSuccessor].strID);
+      }
+    }
+    
+    return lstIDs;
+  }
+  
+  std::string DesignatorRegistry::equationTime(std::string strID) const {
+    const DesignatorRecord* drRecord = this->record(strID);
+    
+    if(drRecord) {
+      return drRecord->strEquationTime;
+    }
+    
+    return "";
+  }
+  
+  std::vector<std::string> DesignatorRegistry::successorClosure(std::string strID) const {
+    std::vector<std::string> vecClosure;
+    std::unordered_map<std::string, unsigned int>::const_iterator itIndex = m_mapRecordIndices.find(strID);
+    
+    if(itIndex == m_mapRecordIndices.end()) {
+      return vecClosure;
+    }
+    
+    unsigned int unStart = itIndex->second;
+    
+    // The walk shares the visit stamps, so it runs under the lock,
+    // too.
+    std::unique_lock<std::mutex> lckClosures(m_mtxSuccessorClosures);
+    std::unordered_map<unsigned int, std::vector<std::string> >::const_iterator itCached = m_mapSuccessorClosures.find(unStart);
+    if(itCached != m_mapSuccessorClosures.end()) {
+      return itCached->second;
+    }
+    
+    // Iterative post-order walk (chains can be long); each entry is
+    // a record and the index of its next successor to visit.
+    std::vector< std::pair<unsigned int, unsigned int> > vecStack;
+    this->beginWalk();
+    vecStack.push_back(std::make_pair(unStart, 0));
+    this->visit(unStart);
+    
+    while(!vecStack.empty()) {
+      std::pair<unsigned int, unsigned int>& prTop = vecStack.back();
+      const std::vector<unsigned int>& vecSuccessors = m_vecRecords[prTop.first].vecSuccessors;
+      
+      if(prTop.second < vecSuccessors.size()) {
+	unsigned int unNext = vecSuccessors[prTop.second++];
+	
+	if(this->visit(unNext)) {
+	  vecStack.push_back(std::make_pair(unNext, 0));
+	}
+      } else {
+	if(prTop.first != unStart) {
+	  vecClosure.push_back(m_vecRecords[prTop.first].strID);
+	}
+	
+	vecStack.pop_back();
+      }
+    }
+    
+    m_mapSuccessorClosures[unStart] = vecClosure;
+    
+    return vecClosure;
+  }
+  
+  std::list<std::string> DesignatorRegistry::equivalentIDs(std::string strID) const {
+    std::list<std::string> lstIDs;
+    std::unordered_map<std::string, unsigned int>::const_iterator itIndex = m_mapRecordIndices.find(strID);
+    
+    if(itIndex != m_mapRecordIndices.end()) {
+      for(unsigned int unMember : m_vecRecords[this->classOf(itIndex->second)].vecClassMembers) {
+	lstIDs.push_back(m_vecRecords[unMember].strID);
+      }
+    }
+    
+    return lstIDs;
+  }
+  
+  bool DesignatorRegistry::equivalent(std::string strIDA, std::string strIDB) const {
+    std::unordered_map<std::string, unsigned int>::const_iterator itIndexA = m_mapRecordIndices.find(strIDA);
+    std::unordered_map<std::string, unsigned int>::const_iterator itIndexB = m_mapRecordIndices.find(strIDB);
+    
+    if(itIndexA == m_mapRecordIndices.end() || itIndexB == m_mapRecordIndices.end()) {
+      return (strIDA == strIDB);
+    }
+    
+    return (this->classOf(itIndexA->second) == this->classOf(itIndexB->second));
+  }
+}
@@ -43,15 +43,21 @@
 namespace semrec {
   static std::list<int> g_lstContextIDs;
   static std::list<int> g_lstPluginIDs;
-  static ConfigSettings g_cfgsetSettings;
+  static std::shared_ptr<const ConfigSettings> g_cfgsetSettings = std::make_shared<ConfigSettings>();
   static std::mutex g_mtxGlobalSettings;
   static std::map<std::string, Designator*> g_mapPluginSettings;
-  static std::mutex g_mtxStatusMessages;
-  static std::list<StatusMessage> g_lstStatusMessages;
-  static int g_nHighestSequenceNumber = 0;
+  static unsigned long g_unHighestSequenceNumber = 0;
   static std::mutex m_mtxSequenceNumberLock;
   static std::map<std::string, int> g_mapIssuedGlobalTokens;
   static std::mutex g_mtxGlobalTokensLock;
+  static std::condition_variable g_cvGlobalTokens;
+  static std::mutex g_mtxCoreWakeup;
+  static std::condition_variable g_cvCoreWakeup;
+  static bool g_bCoreWakeupPending = false;
+  static std::atomic<unsigned long> g_unSubscriptionIndexGeneration(0);
+  static std::atomic<unsigned int> g_unNextServiceEventID(0);
+  static std::map<EventID, std::string> g_mapRegisteredEventNames;
+  static std::mutex g_mtxRegisteredEventNames;
   
   
   void revokeGlobalToken(std::string strToken) {
@@ -70,21 +76,29 @@ namespace semrec {
     return bReturn;
   }
   
+  static bool globalTokenIssued(std::string strToken) {
+    // NOTE: Expects g_mtxGlobalTokensLock to be held.
+    std::map<std::string, int>::iterator itToken = g_mapIssuedGlobalTokens.find(strToken);
+    
+    return (itToken != g_mapIssuedGlobalTokens.end() && itToken->second > 0);
+  }
+  
   bool waitForGlobalToken(std::string strToken, float fTimeout) {
-    // TODO(winkler): The timeout is still not implemented, do that!
+    std::unique_lock<std::mutex> lckTokens(g_mtxGlobalTokensLock);
     
-    while(true) {
-      if(wasGlobalTokenIssued(strToken)) {
-	return true;
-      }
+    if(fTimeout <= 0.0) {
+      g_cvGlobalTokens.wait(lckTokens, std::bind(globalTokenIssued, strToken));
+      
+      return true;
     }
     
-    return false;
+    return g_cvGlobalTokens.wait_for(lckTokens, std::chrono::duration<float>(fTimeout), std::bind(globalTokenIssued, strToken));
   }
   
   void issueGlobalToken(std::string strToken) {
     g_mtxGlobalTokensLock.lock();
     g_mapIssuedGlobalTokens[strToken] = 1;
+    g_cvGlobalTokens.notify_all();
     g_mtxGlobalTokensLock.unlock();
   }
   
@@ -138,6 +152,14 @@ namespace semrec {
     return nID;
   }
   
+  int createServiceEventID() {
+    // Responses are delivered to all plugins, so service event IDs
+    // have to be unique across plugins, not just per plugin. They
+    // wrap around after 2^31 requests and never become negative, as
+    // -1 means "no request".
+    return (int)(g_unNextServiceEventID++ & (unsigned int)std::numeric_limits<int>::max());
+  }
+  
   bool pluginIDTaken(int nID) {
     for(int nIDtemp : g_lstPluginIDs) {
       if(nIDtemp == nID) {
@@ -165,33 +187,30 @@ namespace semrec {
   ServiceEvent defaultServiceEvent(std::string strServiceName) {
     ServiceEvent seDefault;
     seDefault.strServiceName = strServiceName;
+    seDefault.eiServiceID = eventID(strServiceName);
     seDefault.siServiceIdentifier = SI_REQUEST;
     seDefault.smResultModifier = SM_AGGREGATE_RESULTS;
     seDefault.bPreserve = false;
     seDefault.cdDesignator = NULL;
+    seDefault.nRequesterID = -1;
     seDefault.nSequenceNumber = nextSequenceNumber();
     
     return seDefault;
   }
   
-  int nextSequenceNumber() {
+  unsigned long nextSequenceNumber() {
     m_mtxSequenceNumberLock.lock();
-    g_nHighestSequenceNumber++;
-    int nReturn = g_nHighestSequenceNumber;
+    g_unHighestSequenceNumber++;
+    unsigned long unReturn = g_unHighestSequenceNumber;
     m_mtxSequenceNumberLock.unlock();
     
-    return nReturn;
-  }
-  
-  void resetSequenceNumbers() {
-    m_mtxSequenceNumberLock.lock();
-    g_nHighestSequenceNumber = 0;
-    m_mtxSequenceNumberLock.unlock();
+    return unReturn;
   }
   
   Event defaultEvent(std::string strEventName) {
     Event evDefault;
     evDefault.strEventName = strEventName;
+    evDefault.eiEventID = eventID(strEventName);
     evDefault.cdDesignator = NULL;
     evDefault.nOriginID = -1;
     evDefault.nOpenRequestID = -1;
@@ -202,7 +221,7 @@ namespace semrec {
     return evDefault;
   }
   
-  Event eventInResponseTo(Event evRequest, std::string strEventName) {
+  Event eventInResponseTo(const Event& evRequest, std::string strEventName) {
     if(strEventName == "") {
       strEventName = evRequest.strEventName;
     }
@@ -214,7 +233,7 @@ namespace semrec {
     return evDefault;
   }
 
-  ServiceEvent eventInResponseTo(ServiceEvent seRequest, std::string strServiceName) {
+  ServiceEvent eventInResponseTo(const ServiceEvent& seRequest, std::string strServiceName) {
     if(strServiceName == "") {
       strServiceName = seRequest.strServiceName;
     }
@@ -222,33 +241,38 @@ namespace semrec {
     ServiceEvent seDefault = defaultServiceEvent(strServiceName);
     seDefault.siServiceIdentifier = SI_RESPONSE;
     seDefault.nServiceEventID = seRequest.nServiceEventID;
+    seDefault.nRequesterID = seRequest.nRequesterID;
     
     return seDefault;
   }
   
   std::string colorSpecifierForID(int nID, bool bBold) {
-    ConfigSettings cfgSet = configSettings();
-    int nLength = cfgSet.vecPluginOutputColors.size();
+    std::shared_ptr<const ConfigSettings> cfgSet = configSnapshot();
+    int nLength = cfgSet->vecPluginOutputColors.size();
     int nUseIndex = (nID + 3) % nLength;
     
-    return cfgSet.vecPluginOutputColors[nUseIndex];
+    return cfgSet->vecPluginOutputColors[nUseIndex];
   }
   
   std::string normalColorSpecifier() {
     return "\033[0m";
   }
   
+  std::shared_ptr<const ConfigSettings> configSnapshot() {
+    return std::atomic_load(&g_cfgsetSettings);
+  }
+  
   ConfigSettings configSettings() {
-    g_mtxGlobalSettings.lock();
-    ConfigSettings cfgsetReturn = g_cfgsetSettings;
-    g_mtxGlobalSettings.unlock();
-    
-    return cfgsetReturn;
+    return *configSnapshot();
   }
   
   void setConfigSettings(ConfigSettings cfgsetSettings) {
+    std::shared_ptr<const ConfigSettings> cfgsetNew = std::make_shared<ConfigSettings>(cfgsetSettings);
+    
+    // NOTE: Only writers serialize; readers keep using
+    // whichever snapshot they loaded until they drop it.
     g_mtxGlobalSettings.lock();
-    g_cfgsetSettings = cfgsetSettings;
+    std::atomic_store(&g_cfgsetSettings, cfgsetNew);
     g_mtxGlobalSettings.unlock();
   }
   
@@ -266,10 +290,16 @@ namespace semrec {
     return cdReturn;
   }
   
+  MessageSink& messageSink() {
+    // NOTE: Constructed on first use, so messages issued
+    // during static initialization of plugins still have a sink.
+    static MessageSink msSink;
+    
+    return msSink;
+  }
+  
   void queueMessage(StatusMessage msgQueue) {
-    g_mtxStatusMessages.lock();
-    g_lstStatusMessages.push_back(msgQueue);
-    g_mtxStatusMessages.unlock();
+    messageSink().push(msgQueue);
   }
   
   StatusMessage queueMessage(std::string strColorCode, bool bBold, std::string strPrefix, std::string strMessage) {
@@ -284,17 +314,65 @@ namespace semrec {
     return msgQueue;
   }
   
-  std::list<StatusMessage> queuedMessages() {
-    g_mtxStatusMessages.lock();
-    std::list<StatusMessage> lstMessages;
+  bool registerEventName(std::string strName) {
+    bool bUnique = true;
+    EventID eiID = eventID(strName);
+    
+    g_mtxRegisteredEventNames.lock();
+    std::map<EventID, std::string>::iterator itName = g_mapRegisteredEventNames.find(eiID);
+    
+    if(itName == g_mapRegisteredEventNames.end()) {
+      g_mapRegisteredEventNames[eiID] = strName;
+    } else if(itName->second != strName) {
+      bUnique = false;
+    }
+    g_mtxRegisteredEventNames.unlock();
+    
+    return bUnique;
+  }
+  
+  std::string registeredEventName(EventID eiID) {
+    std::string strName = "";
+    
+    g_mtxRegisteredEventNames.lock();
+    std::map<EventID, std::string>::iterator itName = g_mapRegisteredEventNames.find(eiID);
+    
+    if(itName != g_mapRegisteredEventNames.end()) {
+      strName = itName->second;
+    }
+    g_mtxRegisteredEventNames.unlock();
+    
+    return strName;
+  }
+  
+  void invalidateSubscriptionIndex() {
+    g_unSubscriptionIndexGeneration++;
+  }
+  
+  unsigned long subscriptionIndexGeneration() {
+    return g_unSubscriptionIndexGeneration.load();
+  }
+  
+  void notifyCoreWakeup() {
+    g_mtxCoreWakeup.lock();
+    g_bCoreWakeupPending = true;
+    g_mtxCoreWakeup.unlock();
+    
+    g_cvCoreWakeup.notify_one();
+  }
+  
+  bool waitForCoreWakeup(float fTimeout) {
+    std::unique_lock<std::mutex> lckWakeup(g_mtxCoreWakeup);
     
-    if(g_lstStatusMessages.size() > 0) {
-      lstMessages = g_lstStatusMessages;
-      g_lstStatusMessages.clear();
+    // NOTE: Spurious wakeups are not filtered out here on
+    // purpose; they only result in one additional (empty) cycle.
+    if(!g_bCoreWakeupPending) {
+      g_cvCoreWakeup.wait_for(lckWakeup, std::chrono::duration<float>(fTimeout));
     }
     
-    g_mtxStatusMessages.unlock();
+    bool bWokenUp = g_bCoreWakeupPending;
+    g_bCoreWakeupPending = false;
     
-    return lstMessages;
+    return bWokenUp;
   }
 }
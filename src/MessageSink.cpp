@@ -0,0 +1,304 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <semrec/MessageSink.h>
+
+
+namespace semrec {
+  MessageSink::MessageSink(size_t szCapacity) {
+    m_szHead = 0;
+    m_szCount = 0;
+    m_opPolicy = OP_BLOCK;
+    m_bRun = false;
+    m_bWriting = false;
+    m_thrdWriter = NULL;
+    m_bConsoleOutput = true;
+    m_ulDroppedMessages = 0;
+    m_ulWrittenMessages = 0;
+    
+    m_vecRing.resize(szCapacity > 0 ? szCapacity : 1);
+  }
+  
+  MessageSink::~MessageSink() {
+    this->stop();
+  }
+  
+  void MessageSink::start() {
+    m_mtxRing.lock();
+    if(!m_thrdWriter) {
+      m_bRun = true;
+      m_thrdWriter = new std::thread(&MessageSink::writerLoop, this);
+    }
+    m_mtxRing.unlock();
+  }
+  
+  void MessageSink::stop() {
+    m_mtxRing.lock();
+    std::thread* thrdWriter = m_thrdWriter;
+    m_bRun = false;
+    m_mtxRing.unlock();
+    
+    if(thrdWriter) {
+      m_cvNotEmpty.notify_all();
+      m_cvNotFull.notify_all();
+      
+      // The writer drains the ring buffer before it exits.
+      thrdWriter->join();
+      
+      m_mtxRing.lock();
+      m_thrdWriter = NULL;
+      
+      // Messages pushed between the writer's last look and now.
+      std::vector<StatusMessage> vecRemaining;
+      while(m_szCount > 0) {
+	vecRemaining.push_back(std::move(m_vecRing[m_szHead]));
+	m_szHead = (m_szHead + 1) % m_vecRing.size();
+	m_szCount--;
+      }
+      m_mtxRing.unlock();
+      
+      m_cvDrained.notify_all();
+      
+      if(vecRemaining.size() > 0) {
+	this->writeBatch(vecRemaining);
+      }
+      
+      delete thrdWriter;
+    }
+  }
+  
+  bool MessageSink::running() {
+    m_mtxRing.lock();
+    bool bRunning = (m_thrdWriter != NULL);
+    m_mtxRing.unlock();
+    
+    return bRunning;
+  }
+  
+  void MessageSink::writerLoop() {
+    std::vector<StatusMessage> vecBatch;
+    
+    while(true) {
+      std::unique_lock<std::mutex> lckRing(m_mtxRing);
+      
+      while(m_bRun && m_szCount == 0) {
+	m_cvNotEmpty.wait(lckRing);
+      }
+      
+      if(m_szCount == 0) {
+	// Stopped and nothing left to write
+	break;
+      }
+      
+      // Take everything that is buffered right now as one batch.
+      vecBatch.clear();
+      vecBatch.reserve(m_szCount);
+      
+      while(m_szCount > 0) {
+	vecBatch.push_back(std::move(m_vecRing[m_szHead]));
+	m_szHead = (m_szHead + 1) % m_vecRing.size();
+	m_szCount--;
+      }
+      
+      m_bWriting = true;
+      lckRing.unlock();
+      m_cvNotFull.notify_all();
+      
+      this->writeBatch(vecBatch);
+      
+      lckRing.lock();
+      m_bWriting = false;
+      
+      if(m_szCount == 0) {
+	m_cvDrained.notify_all();
+      }
+    }
+    
+    m_cvDrained.notify_all();
+  }
+  
+  void MessageSink::writeBatch(const std::vector<StatusMessage>& vecMessages) {
+    m_mtxOutput.lock();
+    
+    if(m_bConsoleOutput) {
+      std::string strOutput;
+      
+      for(const StatusMessage& msgStatus : vecMessages) {
+	strOutput += "\033[";
+	strOutput += (msgStatus.bBold ? "1" : "0");
+	strOutput += ";" + msgStatus.strColorCode + "m";
+	strOutput += "[ " + msgStatus.strPrefix + " ] " + msgStatus.strMessage + "\033[0m\n";
+      }
+      
+      std::cout << strOutput << std::flush;
+    }
+    
+    for(StatusMessageConsumer* smcConsumer : m_lstConsumers) {
+      smcConsumer->consumeStatusMessages(vecMessages);
+    }
+    
+    m_ulWrittenMessages += vecMessages.size();
+    
+    m_mtxOutput.unlock();
+  }
+  
+  void MessageSink::setCapacity(size_t szCapacity) {
+    if(szCapacity == 0) {
+      szCapacity = 1;
+    }
+    
+    m_mtxRing.lock();
+    std::vector<StatusMessage> vecRing(szCapacity);
+    
+    // Keep the newest messages if they don't all fit.
+    while(m_szCount > szCapacity) {
+      m_szHead = (m_szHead + 1) % m_vecRing.size();
+      m_szCount--;
+      m_ulDroppedMessages++;
+    }
+    
+    for(size_t szI = 0; szI < m_szCount; szI++) {
+      vecRing[szI] = std::move(m_vecRing[(m_szHead + szI) % m_vecRing.size()]);
+    }
+    
+    m_vecRing.swap(vecRing);
+    m_szHead = 0;
+    m_mtxRing.unlock();
+    
+    m_cvNotFull.notify_all();
+  }
+  
+  size_t MessageSink::capacity() {
+    m_mtxRing.lock();
+    size_t szCapacity = m_vecRing.size();
+    m_mtxRing.unlock();
+    
+    return szCapacity;
+  }
+  
+  void MessageSink::setOverflowPolicy(OverflowPolicy opPolicy) {
+    m_mtxRing.lock();
+    m_opPolicy = opPolicy;
+    m_mtxRing.unlock();
+    
+    m_cvNotFull.notify_all();
+  }
+  
+  MessageSink::OverflowPolicy MessageSink::overflowPolicy() {
+    m_mtxRing.lock();
+    OverflowPolicy opPolicy = m_opPolicy;
+    m_mtxRing.unlock();
+    
+    return opPolicy;
+  }
+  
+  void MessageSink::setConsoleOutput(bool bConsoleOutput) {
+    m_bConsoleOutput = bConsoleOutput;
+  }
+  
+  bool MessageSink::consoleOutput() {
+    return m_bConsoleOutput;
+  }
+  
+  void MessageSink::addConsumer(StatusMessageConsumer* smcConsumer) {
+    m_mtxOutput.lock();
+    m_lstConsumers.remove(smcConsumer);
+    m_lstConsumers.push_back(smcConsumer);
+    m_mtxOutput.unlock();
+  }
+  
+  void MessageSink::removeConsumer(StatusMessageConsumer* smcConsumer) {
+    // NOTE: Taking the output lock waits for a delivery
+    // that might currently be in progress.
+    m_mtxOutput.lock();
+    m_lstConsumers.remove(smcConsumer);
+    m_mtxOutput.unlock();
+  }
+  
+  bool MessageSink::push(const StatusMessage& msgStatus) {
+    std::unique_lock<std::mutex> lckRing(m_mtxRing);
+    
+    if(!m_thrdWriter) {
+      lckRing.unlock();
+      this->writeBatch(std::vector<StatusMessage>(1, msgStatus));
+      
+      return true;
+    }
+    
+    if(m_szCount == m_vecRing.size()) {
+      // The writer thread (i.e. a consumer issuing messages) must
+      // never wait for space, as it is the one making it.
+      if(m_opPolicy == OP_BLOCK && std::this_thread::get_id() != m_thrdWriter->get_id()) {
+	while(m_bRun && m_opPolicy == OP_BLOCK && m_szCount == m_vecRing.size()) {
+	  m_cvNotFull.wait(lckRing);
+	}
+      }
+      
+      if(m_szCount == m_vecRing.size()) {
+	m_ulDroppedMessages++;
+	
+	return false;
+      }
+    }
+    
+    m_vecRing[(m_szHead + m_szCount) % m_vecRing.size()] = msgStatus;
+    m_szCount++;
+    lckRing.unlock();
+    
+    m_cvNotEmpty.notify_one();
+    
+    return true;
+  }
+  
+  void MessageSink::flush() {
+    std::unique_lock<std::mutex> lckRing(m_mtxRing);
+    
+    if(m_thrdWriter && std::this_thread::get_id() != m_thrdWriter->get_id()) {
+      while(m_thrdWriter && (m_szCount > 0 || m_bWriting)) {
+	m_cvDrained.wait(lckRing);
+      }
+    }
+  }
+  
+  unsigned long MessageSink::droppedMessages() {
+    return m_ulDroppedMessages.load();
+  }
+  
+  unsigned long MessageSink::writtenMessages() {
+    return m_ulWrittenMessages.load();
+  }
+}
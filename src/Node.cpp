@@ -59,13 +59,22 @@ namespace semrec {
   Node::~Node() {
     this->clearSubnodes();
     this->clearDescription();
+    this->clearAttachments();
   }
   
   void Node::init() {
     m_strTitle = "";
-    m_ckvpMetaInformation = new KeyValuePair();
+    m_bOwnsSubnodes = true;
     m_ndParent = NULL;
+    m_ndPreviousSibling = NULL;
+    m_ndNextSibling = NULL;
+    m_unIndexInParent = 0;
     m_nID = 0;
+    m_ucFlags = 0;
+    m_nDetailLevel = 0;
+    m_dTimeStart = 0.0;
+    m_dTimeEnd = 0.0;
+    m_bMetaInformationDirty = true;
   }
   
   void Node::setDescription(std::list<KeyValuePair*> lstDescription) {
@@ -83,11 +92,48 @@ namespace semrec {
   }
   
   void Node::clearSubnodes() {
-    for(Node* ndCurrent : m_lstSubnodes) {
-      delete ndCurrent;
+    if(m_bOwnsSubnodes) {
+      for(Node* ndCurrent : m_vecSubnodes) {
+	delete ndCurrent;
+      }
+    }
+    
+    m_vecSubnodes.clear();
+  }
+  
+  void Node::clearAttachments() {
+    for(KeyValuePair* ckvpObject : m_vecObjects) {
+      delete ckvpObject;
+    }
+    
+    for(KeyValuePair* ckvpHuman : m_vecHumans) {
+      delete ckvpHuman;
+    }
+    
+    for(NodeDesignator& ndgDesignator : m_vecDesignators) {
+      delete ndgDesignator.ckvpDescription;
+    }
+    
+    m_vecImages.clear();
+    m_vecObjects.clear();
+    m_vecHumans.clear();
+    m_vecFailures.clear();
+    m_vecCaughtFailures.clear();
+    m_vecDesignators.clear();
+  }
+  
+  void Node::setFlag(unsigned char ucFlag, bool bSet) {
+    if(bSet) {
+      m_ucFlags |= ucFlag;
+    } else {
+      m_ucFlags &= ~ucFlag;
     }
     
-    m_lstSubnodes.clear();
+    m_bMetaInformationDirty = true;
+  }
+  
+  bool Node::flag(unsigned char ucFlag) {
+    return ((m_ucFlags & ucFlag) != 0);
   }
   
   std::list<KeyValuePair*> Node::description() {
@@ -103,12 +149,73 @@ namespace semrec {
   }
   
   void Node::addSubnode(Node* ndAdd) {
+    Node* ndLast = this->lastSubnode();
+    
     ndAdd->setParent(this);
-    m_lstSubnodes.push_back(ndAdd);
+    ndAdd->m_unIndexInParent = m_vecSubnodes.size();
+    ndAdd->m_ndPreviousSibling = ndLast;
+    ndAdd->m_ndNextSibling = NULL;
+    
+    if(ndLast) {
+      ndLast->m_ndNextSibling = ndAdd;
+    }
+    
+    m_vecSubnodes.push_back(ndAdd);
   }
   
-  std::list<Node*> Node::subnodes() {
-    return m_lstSubnodes;
+  const std::vector<Node*>& Node::subnodes() {
+    return m_vecSubnodes;
+  }
+  
+  unsigned int Node::subnodeCount() {
+    return m_vecSubnodes.size();
+  }
+  
+  Node* Node::firstSubnode() {
+    return (m_vecSubnodes.empty() ? NULL : m_vecSubnodes.front());
+  }
+  
+  Node* Node::lastSubnode() {
+    return (m_vecSubnodes.empty() ? NULL : m_vecSubnodes.back());
+  }
+  
+  Node* Node::previousSibling() {
+    return m_ndPreviousSibling;
+  }
+  
+  Node* Node::nextSibling() {
+    return m_ndNextSibling;
+  }
+  
+  unsigned int Node::indexInParent() {
+    return m_unIndexInParent;
+  }
+  
+  void Node::accept(NodeVisitor& nvVisitor) {
+    Node* ndCurrent = this;
+    
+    while(ndCurrent) {
+      if(nvVisitor.enterNode(ndCurrent) && ndCurrent->firstSubnode()) {
+	ndCurrent = ndCurrent->firstSubnode();
+      } else {
+	// Leave this node and all ancestors whose last sub-node it
+	// is, then continue with the next sibling.
+	while(ndCurrent) {
+	  nvVisitor.leaveNode(ndCurrent);
+	  
+	  if(ndCurrent == this) {
+	    return;
+	  }
+	  
+	  if(ndCurrent->nextSibling()) {
+	    ndCurrent = ndCurrent->nextSibling();
+	    break;
+	  }
+	  
+	  ndCurrent = ndCurrent->parent();
+	}
+      }
+    }
   }
   
   void Node::setUniqueID(std::string strUniqueID) {
@@ -125,7 +232,7 @@ namespace semrec {
     if(m_strUniqueID == strUniqueID) {
       bReturnvalue = true;
     } else {
-      for(Node* ndCurrent : m_lstSubnodes) {
+      for(Node* ndCurrent : m_vecSubnodes) {
 	if(ndCurrent->includesUniqueID(strUniqueID)) {
 	  bReturnvalue = true;
 	  break;
@@ -137,7 +244,116 @@ namespace semrec {
   }
   
   KeyValuePair* Node::metaInformation() {
-    return m_ckvpMetaInformation;
+    if(m_bMetaInformationDirty) {
+      // Rebuild in place, so that pointers handed out earlier stay
+      // valid.
+      for(std::string strKey : m_ckvpMetaInformation.childKeys()) {
+	m_ckvpMetaInformation.removeChildForKey(strKey);
+      }
+      
+      m_ckvpMetaInformation.setValue(std::string("success"), (this->success() ? 1 : 0));
+      m_ckvpMetaInformation.setValue(std::string("prematurely-ended"), (this->prematurelyEnded() ? 1 : 0));
+      m_ckvpMetaInformation.setValue(std::string("detail-level"), m_nDetailLevel);
+      
+      if(this->hasTimeStart()) {
+	m_ckvpMetaInformation.setValue(std::string("time-start"), m_strTimeStart);
+      }
+      
+      if(this->hasTimeEnd()) {
+	m_ckvpMetaInformation.setValue(std::string("time-end"), m_strTimeEnd);
+      }
+      
+      if(m_strTimeStartSystem != "") {
+	m_ckvpMetaInformation.setValue(std::string("time-start-system"), m_strTimeStartSystem);
+      }
+      
+      if(m_strClass != "") {
+	m_ckvpMetaInformation.setValue(std::string("class"), m_strClass);
+	
+	if(m_strClassNamespace != "") {
+	  m_ckvpMetaInformation.setValue(std::string("classnamespace"), m_strClassNamespace);
+	}
+      }
+      
+      if(m_vecImages.size() > 0) {
+	KeyValuePair* ckvpImages = m_ckvpMetaInformation.addChild("images");
+	
+	for(unsigned int unI = 0; unI < m_vecImages.size(); unI++) {
+	  KeyValuePair* ckvpImage = ckvpImages->addChild("image-" + std::to_string(unI));
+	  ckvpImage->setValue(std::string("origin"), m_vecImages[unI].strOrigin);
+	  ckvpImage->setValue(std::string("filename"), m_vecImages[unI].strFilename);
+	  ckvpImage->setValue(std::string("time-capture"), m_vecImages[unI].strTimeCapture);
+	}
+      }
+      
+      if(m_vecObjects.size() > 0) {
+	KeyValuePair* ckvpObjects = m_ckvpMetaInformation.addChild("objects");
+	
+	for(unsigned int unI = 0; unI < m_vecObjects.size(); unI++) {
+	  KeyValuePair* ckvpObject = ckvpObjects->addChild("object-" + std::to_string(unI));
+	  
+	  for(KeyValuePair* ckvpChild : m_vecObjects[unI]->children()) {
+	    ckvpObject->addChild(ckvpChild->copy());
+	  }
+	}
+      }
+      
+      if(m_vecHumans.size() > 0) {
+	KeyValuePair* ckvpHumans = m_ckvpMetaInformation.addChild("humans");
+	
+	for(unsigned int unI = 0; unI < m_vecHumans.size(); unI++) {
+	  KeyValuePair* ckvpHuman = ckvpHumans->addChild("human-" + std::to_string(unI));
+	  
+	  for(KeyValuePair* ckvpChild : m_vecHumans[unI]->children()) {
+	    ckvpHuman->addChild(ckvpChild->copy());
+	  }
+	}
+      }
+      
+      if(m_vecFailures.size() > 0) {
+	KeyValuePair* ckvpFailures = m_ckvpMetaInformation.addChild("failures");
+	
+	for(unsigned int unI = 0; unI < m_vecFailures.size(); unI++) {
+	  KeyValuePair* ckvpFailure = ckvpFailures->addChild("failure-" + std::to_string(unI));
+	  ckvpFailure->setValue(std::string("condition"), m_vecFailures[unI].strCondition);
+	  ckvpFailure->setValue(std::string("time-fail"), m_vecFailures[unI].strTimeFail);
+	}
+      }
+      
+      if(m_vecCaughtFailures.size() > 0) {
+	KeyValuePair* ckvpCaughtFailures = m_ckvpMetaInformation.addChild("caught_failures");
+	
+	for(unsigned int unI = 0; unI < m_vecCaughtFailures.size(); unI++) {
+	  std::stringstream sts;
+	  sts << m_vecCaughtFailures[unI].ndEmitter;
+	  
+	  KeyValuePair* ckvpCaughtFailure = ckvpCaughtFailures->addChild("caught_failure-" + std::to_string(unI));
+	  ckvpCaughtFailure->setValue(std::string("failure-id"), m_vecCaughtFailures[unI].strFailureID);
+	  ckvpCaughtFailure->setValue(std::string("time-catch"), m_vecCaughtFailures[unI].strTimeCatch);
+	  ckvpCaughtFailure->setValue(std::string("emitter-id"), sts.str());
+	}
+      }
+      
+      if(m_vecDesignators.size() > 0) {
+	KeyValuePair* ckvpDesignators = m_ckvpMetaInformation.addChild("designators");
+	
+	for(unsigned int unI = 0; unI < m_vecDesignators.size(); unI++) {
+	  KeyValuePair* ckvpDesignator = ckvpDesignators->addChild("designator-" + std::to_string(unI));
+	  ckvpDesignator->setValue(std::string("type"), m_vecDesignators[unI].strType);
+	  ckvpDesignator->setValue(std::string("id"), m_vecDesignators[unI].strID);
+	  ckvpDesignator->setValue(std::string("annotation"), m_vecDesignators[unI].strAnnotation);
+	  
+	  KeyValuePair* ckvpDescription = ckvpDesignator->addChild("description");
+	  for(KeyValuePair* ckvpChild : m_vecDesignators[unI].ckvpDescription->children()) {
+	    ckvpDescription->addChild(ckvpChild->copy());
+	  }
+	}
+      }
+      
+      m_bMetaInformationDirty = false;
+    }
+    
+    return &m_ckvpMetaInformation;
   }
   
   void Node::setID(int nID) {
@@ -151,7 +367,7 @@ namespace semrec {
   int Node::highestID() {
     int nHighestID = m_nID;
     
-    for(Node* ndCurrent : m_lstSubnodes) {
+    for(Node* ndCurrent : m_vecSubnodes) {
       nHighestID = std::max(nHighestID, ndCurrent->highestID());
     }
     
@@ -178,110 +394,182 @@ namespace semrec {
     }
   }
   
+  bool Node::hasAncestor(Node* ndAncestor) {
+    for(Node* ndCurrent = m_ndParent; ndCurrent != NULL; ndCurrent = ndCurrent->parent()) {
+      if(ndCurrent == ndAncestor) {
+	return true;
+      }
+    }
+    
+    return false;
+  }
+  
   void Node::setPrematurelyEnded(bool bPrematurelyEnded) {
-    this->metaInformation()->setValue(std::string("prematurely-ended"), (bPrematurelyEnded ? 1 : 0));
+    this->setFlag(NF_PREMATURELY_ENDED, bPrematurelyEnded);
   }
   
   bool Node::prematurelyEnded() {
-    return (this->metaInformation()->floatValue("prematurely-ended") == 0 ? false : true);
+    return this->flag(NF_PREMATURELY_ENDED);
   }
   
-  KeyValuePair* Node::addDescriptionListItem(std::string strDomain, std::string strPrefix) {
-    KeyValuePair* ckvpList = this->metaInformation()->addChild(strDomain);
-    
-    std::stringstream sts;
-    sts << strPrefix << "-";
-    sts << ckvpList->children().size();
-    
-    return ckvpList->addChild(sts.str());
+  void Node::setDetailLevel(int nDetailLevel) {
+    m_nDetailLevel = nDetailLevel;
+    m_bMetaInformationDirty = true;
+  }
+  
+  int Node::detailLevel() {
+    return m_nDetailLevel;
+  }
+  
+  void Node::setClass(std::string strClass, std::string strClassNamespace) {
+    m_strClass = strClass;
+    m_strClassNamespace = strClassNamespace;
+    m_bMetaInformationDirty = true;
+  }
+  
+  std::string Node::className() {
+    return m_strClass;
+  }
+  
+  std::string Node::classNamespace() {
+    return m_strClassNamespace;
+  }
+  
+  void Node::setTimeStart(double dTimeStart, std::string strTimeStart) {
+    m_dTimeStart = dTimeStart;
+    m_strTimeStart = strTimeStart;
+    this->setFlag(NF_HAS_TIME_START, true);
+  }
+  
+  double Node::timeStart() {
+    return m_dTimeStart;
+  }
+  
+  std::string Node::timeStartString() {
+    return m_strTimeStart;
+  }
+  
+  bool Node::hasTimeStart() {
+    return this->flag(NF_HAS_TIME_START);
+  }
+  
+  void Node::setTimeEnd(double dTimeEnd, std::string strTimeEnd) {
+    m_dTimeEnd = dTimeEnd;
+    m_strTimeEnd = strTimeEnd;
+    this->setFlag(NF_HAS_TIME_END, true);
+  }
+  
+  double Node::timeEnd() {
+    return m_dTimeEnd;
+  }
+  
+  std::string Node::timeEndString() {
+    return m_strTimeEnd;
+  }
+  
+  bool Node::hasTimeEnd() {
+    return this->flag(NF_HAS_TIME_END);
+  }
+  
+  void Node::setTimeStartSystem(std::string strTimeStartSystem) {
+    m_strTimeStartSystem = strTimeStartSystem;
+    m_bMetaInformationDirty = true;
+  }
+  
+  std::string Node::timeStartSystemString() {
+    return m_strTimeStartSystem;
+  }
+  
+  const std::vector<NodeImage>& Node::images() {
+    return m_vecImages;
+  }
+  
+  const std::vector<KeyValuePair*>& Node::objects() {
+    return m_vecObjects;
+  }
+  
+  const std::vector<KeyValuePair*>& Node::humans() {
+    return m_vecHumans;
+  }
+  
+  const std::vector<NodeFailure>& Node::failures() {
+    return m_vecFailures;
+  }
+  
+  const std::vector<NodeCaughtFailure>& Node::caughtFailures() {
+    return m_vecCaughtFailures;
+  }
+  
+  const std::vector<NodeDesignator>& Node::designators() {
+    return m_vecDesignators;
   }
   
   std::string Node::addImage(std::string strOrigin, std::string strFilename, std::string strTimestamp) {
-    KeyValuePair* ckvpImage = this->addDescriptionListItem("images", "image");
-    
-    ckvpImage->setValue(std::string("origin"), strOrigin);
-    ckvpImage->setValue(std::string("filename"), strFilename);
-    ckvpImage->setValue(std::string("time-capture"), strTimestamp);
+    m_vecImages.push_back({strOrigin, strFilename, strTimestamp});
+    m_bMetaInformationDirty = true;
     
-    return ckvpImage->key();
+    return "image-" + std::to_string(m_vecImages.size() - 1);
   }
   
   std::string Node::addObject(std::list<KeyValuePair*> lstDescription) {
-    KeyValuePair* ckvpObject = this->addDescriptionListItem("objects", "object");
+    KeyValuePair* ckvpObject = new KeyValuePair();
     
     for(KeyValuePair* ckvpPair : lstDescription) {
       ckvpObject->addChild(ckvpPair->copy());
     }
     
-    return ckvpObject->key();
+    m_vecObjects.push_back(ckvpObject);
+    m_bMetaInformationDirty = true;
+    
+    return "object-" + std::to_string(m_vecObjects.size() - 1);
   }
 
   std::string Node::addHuman(std::list<KeyValuePair*> lstDescription) {
-    KeyValuePair* ckvpObject = this->addDescriptionListItem("humans", "human");
+    KeyValuePair* ckvpHuman = new KeyValuePair();
     
     for(KeyValuePair* ckvpPair : lstDescription) {
-      ckvpObject->addChild(ckvpPair->copy());
+      ckvpHuman->addChild(ckvpPair->copy());
     }
     
-    return ckvpObject->key();
+    m_vecHumans.push_back(ckvpHuman);
+    m_bMetaInformationDirty = true;
+    
+    return "human-" + std::to_string(m_vecHumans.size() - 1);
   }
 
   std::string Node::addFailure(std::string strCondition, std::string strTimestamp) {
-    KeyValuePair* ckvpFailure = this->addDescriptionListItem("failures", "failure");
+    m_vecFailures.push_back({strCondition, strTimestamp});
+    m_bMetaInformationDirty = true;
     
-    ckvpFailure->setValue(std::string("condition"), strCondition);
-    ckvpFailure->setValue(std::string("time-fail"), strTimestamp);
-    
-    return ckvpFailure->key();
+    return "failure-" + std::to_string(m_vecFailures.size() - 1);
   }
   
   std::string Node::catchFailure(std::string strFailureID, Node* ndEmitter, std::string strTimestamp) {
-    std::stringstream sts;
-    sts << ndEmitter;
-    
-    KeyValuePair* ckvpFailure = this->addDescriptionListItem("caught_failures", "caught_failure");
-    
-    ckvpFailure->setValue(std::string("failure-id"), strFailureID);
-    ckvpFailure->setValue(std::string("time-catch"), strTimestamp);
-    ckvpFailure->setValue(std::string("emitter-id"), sts.str());
+    m_vecCaughtFailures.push_back({strFailureID, strTimestamp, ndEmitter});
+    m_bMetaInformationDirty = true;
     
-    m_lstCaughtFailures.push_back(std::make_pair(strFailureID, ndEmitter));
-    
-    return ckvpFailure->key();
+    return "caught_failure-" + std::to_string(m_vecCaughtFailures.size() - 1);
   }
   
   void Node::removeCaughtFailure(std::string strFailureID) {
-    for(std::list< std::pair<std::string, Node*> >::iterator itPr = m_lstCaughtFailures.begin();
-	itPr != m_lstCaughtFailures.end();
-	itPr++) {
-      std::pair<std::string, Node*> prCurrent = *itPr;
-      
-      if(prCurrent.first == strFailureID) {
-	m_lstCaughtFailures.erase(itPr);
+    for(std::vector<NodeCaughtFailure>::iterator itCaught = m_vecCaughtFailures.begin();
+	itCaught != m_vecCaughtFailures.end();
+	itCaught++) {
+      if((*itCaught).strFailureID == strFailureID) {
+	m_vecCaughtFailures.erase(itCaught);
+	m_bMetaInformationDirty = true;
 	break;
       }
     }
-    
-    KeyValuePair* ckvpCaughtFailures = this->metaInformation()->childForKey("caught_failures");
-    if(ckvpCaughtFailures) {
-      for(KeyValuePair* ckvpCaughtFailure : ckvpCaughtFailures->children()) {
-	std::string strCurrentFailureID = ckvpCaughtFailure->stringValue("failure-id");
-	
-	if(strCurrentFailureID == strFailureID) {
-	  ckvpCaughtFailures->removeChildForKey(ckvpCaughtFailure->key());
-	  break;
-	}
-      }
-    }
   }
   
   Node* Node::emitterForCaughtFailure(std::string strFailureID, std::string strEmitterID, std::string strTimestamp) {
-    for(std::pair<std::string, Node*> prCurrent : m_lstCaughtFailures) {
+    for(NodeCaughtFailure& ncfCurrent : m_vecCaughtFailures) {
       std::stringstream sts;
-      sts << prCurrent.second;
+      sts << ncfCurrent.ndEmitter;
       
-      if(prCurrent.first == strFailureID && sts.str() == strEmitterID) {
-	return prCurrent.second;
+      if(ncfCurrent.strFailureID == strFailureID && sts.str() == strEmitterID) {
+	return ncfCurrent.ndEmitter;
       }
     }
     
@@ -289,30 +577,24 @@ namespace semrec {
   }
   
   bool Node::hasFailures() {
-    KeyValuePair* ckvpList = this->metaInformation()->childForKey("failures");
-    
-    if(ckvpList) {
-      return (ckvpList->children().size() > 0);
-    }
-    
-    return false;
+    return (m_vecFailures.size() > 0);
   }
   
   void Node::addDesignator(std::string strType, std::list<KeyValuePair*> lstDescription, std::string strUniqueID, std::string strAnnotation) {
-    KeyValuePair* ckvpDesignator = this->addDescriptionListItem("designators", "designator");
+    KeyValuePair* ckvpDescription = new KeyValuePair("description");
     
-    ckvpDesignator->setValue(std::string("type"), strType);
-    ckvpDesignator->setValue(std::string("id"), strUniqueID);
-    ckvpDesignator->setValue(std::string("annotation"), strAnnotation);
-    
-    KeyValuePair* ckvpDescription = ckvpDesignator->addChild("description");
+    // NOTE: The description items are taken over, not
+    // copied.
     for(KeyValuePair* ckvpChild : lstDescription) {
       ckvpDescription->addChild(ckvpChild);
     }
+    
+    m_vecDesignators.push_back({strType, strUniqueID, strAnnotation, ckvpDescription});
+    m_bMetaInformationDirty = true;
   }
   
   void Node::setSuccess(bool bSuccess) {
-    this->metaInformation()->setValue(std::string("success"), (bSuccess ? 1 : 0));
+    this->setFlag(NF_SUCCESS, bSuccess);
   }
   
   void Node::setSuccess(int nSuccess) {
@@ -320,36 +602,10 @@ namespace semrec {
   }
   
   bool Node::success() {
-    return (this->metaInformation()->floatValue(std::string("success")) == 1 ? true : false);
+    return this->flag(NF_SUCCESS);
   }
   
   Node* Node::previousNode() {
-    Node* ndPrevious = NULL;
-    
-    if(m_ndParent != NULL) {
-      std::list<Node*> lstNodes = m_ndParent->subnodes();
-      Node* ndLast = NULL;
-      
-      for(Node* ndNode : lstNodes) {
-	if(ndNode == this) {
-	  ndPrevious = ndLast;
-	  break;
-	} else {
-	  ndLast = ndNode;
-	}
-      }
-    }
-    
-    return ndPrevious;
-  }
-  
-  void Node::ensureProperty(std::string strKey, std::string strDefaultValue) {
-    if(this->metaInformation()->childForKey(strKey) == NULL) {
-      this->metaInformation()->setValue(strKey, strDefaultValue);
-    }
-    
-    for(Node* ndChild : m_lstSubnodes) {
-      ndChild->ensureProperty(strKey, strDefaultValue);
-    }
+    return m_ndPreviousSibling;
   }
 }
@@ -0,0 +1,188 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <semrec/NodeArena.h>
+
+
+namespace semrec {
+  NodeArena::NodeArena(unsigned int unNodesPerBlock) {
+    m_unNodesPerBlock = (unNodesPerBlock > 0 ? unNodesPerBlock : 1);
+    m_unUsedInLastBlock = 0;
+    m_bRetired = false;
+  }
+  
+  NodeArena::~NodeArena() {
+    this->clear();
+    
+    for(Node* ndBlock : m_vecBlocks) {
+      ::operator delete(ndBlock);
+    }
+  }
+  
+  Node* NodeArena::createNode(std::string strTitle) {
+    if(m_vecBlocks.size() == 0 || m_unUsedInLastBlock == m_unNodesPerBlock) {
+      m_vecBlocks.push_back(static_cast<Node*>(::operator new(sizeof(Node) * m_unNodesPerBlock)));
+      m_unUsedInLastBlock = 0;
+    }
+    
+    Node* ndNew = new(m_vecBlocks.back() + m_unUsedInLastBlock) Node(strTitle);
+    ndNew->m_bOwnsSubnodes = false;
+    m_unUsedInLastBlock++;
+    
+    return ndNew;
+  }
+  
+  Node* NodeArena::copyNode(Node* ndOriginal) {
+    Node* ndCopy = this->createNode(ndOriginal->m_strTitle);
+    
+    ndCopy->m_strUniqueID = ndOriginal->m_strUniqueID;
+    ndCopy->m_nID = ndOriginal->m_nID;
+    ndCopy->setDescription(ndOriginal->m_lstDescription);
+    ndCopy->m_ucFlags = ndOriginal->m_ucFlags;
+    ndCopy->m_nDetailLevel = ndOriginal->m_nDetailLevel;
+    ndCopy->m_dTimeStart = ndOriginal->m_dTimeStart;
+    ndCopy->m_dTimeEnd = ndOriginal->m_dTimeEnd;
+    ndCopy->m_strTimeStart = ndOriginal->m_strTimeStart;
+    ndCopy->m_strTimeEnd = ndOriginal->m_strTimeEnd;
+    ndCopy->m_strTimeStartSystem = ndOriginal->m_strTimeStartSystem;
+    ndCopy->m_strClass = ndOriginal->m_strClass;
+    ndCopy->m_strClassNamespace = ndOriginal->m_strClassNamespace;
+    ndCopy->m_vecImages = ndOriginal->m_vecImages;
+    ndCopy->m_vecFailures = ndOriginal->m_vecFailures;
+    ndCopy->m_vecCaughtFailures = ndOriginal->m_vecCaughtFailures;
+    
+    for(KeyValuePair* ckvpObject : ndOriginal->m_vecObjects) {
+      ndCopy->m_vecObjects.push_back(ckvpObject->copy());
+    }
+    
+    for(KeyValuePair* ckvpHuman : ndOriginal->m_vecHumans) {
+      ndCopy->m_vecHumans.push_back(ckvpHuman->copy());
+    }
+    
+    for(NodeDesignator& ndgDesignator : ndOriginal->m_vecDesignators) {
+      ndCopy->m_vecDesignators.push_back({ndgDesignator.strType, ndgDesignator.strID, ndgDesignator.strAnnotation, ndgDesignator.ckvpDescription->copy()});
+    }
+    
+    return ndCopy;
+  }
+  
+  std::list<Node*> NodeArena::copyTrees(std::list<Node*> lstRoots, std::unordered_map<Node*, Node*>& mapCopies) {
+    // Builds the copies while walking the originals; the stack
+    // holds the copies of the nodes currently being visited.
+    class CopyVisitor : public NodeVisitor {
+    public:
+      NodeArena* m_naTarget;
+      std::unordered_map<Node*, Node*>* m_mapCopies;
+      std::vector<Node*> m_vecStack;
+      
+      bool enterNode(Node* ndNode) {
+	Node* ndCopy = m_naTarget->copyNode(ndNode);
+	
+	if(m_vecStack.size() > 0) {
+	  m_vecStack.back()->addSubnode(ndCopy);
+	}
+	
+	(*m_mapCopies)[ndNode] = ndCopy;
+	m_vecStack.push_back(ndCopy);
+	
+	return true;
+      }
+      
+      void leaveNode(Node* ndNode) {
+	m_vecStack.pop_back();
+      }
+    } cvCopy;
+    
+    cvCopy.m_naTarget = this;
+    cvCopy.m_mapCopies = &mapCopies;
+    
+    std::list<Node*> lstCopies;
+    
+    for(Node* ndRoot : lstRoots) {
+      ndRoot->accept(cvCopy);
+      lstCopies.push_back(mapCopies[ndRoot]);
+    }
+    
+    // Emitters can be anywhere in the trees, so they are only
+    // relinked once everything was copied.
+    for(std::pair<Node* const, Node*>& prCopy : mapCopies) {
+      for(NodeCaughtFailure& ncfCaught : prCopy.second->m_vecCaughtFailures) {
+	std::unordered_map<Node*, Node*>::iterator itEmitter = mapCopies.find(ncfCaught.ndEmitter);
+	ncfCaught.ndEmitter = (itEmitter != mapCopies.end() ? itEmitter->second : NULL);
+      }
+    }
+    
+    return lstCopies;
+  }
+  
+  void NodeArena::clear() {
+    for(unsigned int unBlock = 0; unBlock < m_vecBlocks.size(); unBlock++) {
+      unsigned int unUsed = (unBlock == m_vecBlocks.size() - 1 ? m_unUsedInLastBlock : m_unNodesPerBlock);
+      Node* ndBlock = m_vecBlocks[unBlock];
+      
+      for(unsigned int unNode = 0; unNode < unUsed; unNode++) {
+	ndBlock[unNode].~Node();
+      }
+      
+      if(unBlock > 0) {
+	::operator delete(ndBlock);
+      }
+    }
+    
+    if(m_vecBlocks.size() > 1) {
+      m_vecBlocks.resize(1);
+    }
+    
+    m_unUsedInLastBlock = 0;
+  }
+  
+  unsigned int NodeArena::size() {
+    if(m_vecBlocks.size() == 0) {
+      return 0;
+    }
+    
+    return (m_vecBlocks.size() - 1) * m_unNodesPerBlock + m_unUsedInLastBlock;
+  }
+  
+  void NodeArena::retire() {
+    m_bRetired = true;
+  }
+  
+  bool NodeArena::retired() {
+    return m_bRetired;
+  }
+}
@@ -0,0 +1,220 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <semrec/OutputSink.h>
+
+
+namespace semrec {
+  StringOutputSink::StringOutputSink() {
+  }
+  
+  StringOutputSink::~StringOutputSink() {
+  }
+  
+  bool StringOutputSink::write(const char* acData, size_t szLength) {
+    m_strContent.append(acData, szLength);
+    
+    return true;
+  }
+  
+  const std::string& StringOutputSink::content() {
+    return m_strContent;
+  }
+  
+  void StringOutputSink::clear() {
+    m_strContent.clear();
+  }
+  
+  BufferedFileWriter::BufferedFileWriter(size_t szBufferSize) {
+    m_nFileDescriptor = -1;
+    m_acBuffer = NULL;
+    m_szBufferSize = (szBufferSize > 0 ? szBufferSize : 4096);
+    m_szBuffered = 0;
+    m_ullBytesWritten = 0;
+    m_bGood = false;
+  }
+  
+  BufferedFileWriter::~BufferedFileWriter() {
+    this->close();
+    
+    if(m_acBuffer) {
+      free(m_acBuffer);
+    }
+  }
+  
+  bool BufferedFileWriter::open(std::string strFilename, bool bAppend) {
+    this->close();
+    
+    if(!m_acBuffer) {
+      void* vdBuffer = NULL;
+      
+      // Page aligned, so full buffers map onto whole pages.
+      if(posix_memalign(&vdBuffer, 4096, m_szBufferSize) != 0) {
+	return false;
+      }
+      
+      m_acBuffer = (char*)vdBuffer;
+    }
+    
+    int nFlags = O_WRONLY | O_CREAT | (bAppend ? O_APPEND : O_TRUNC);
+    m_nFileDescriptor = ::open(strFilename.c_str(), nFlags, 0644);
+    
+    m_szBuffered = 0;
+    m_ullBytesWritten = 0;
+    m_bGood = (m_nFileDescriptor != -1);
+    
+    return m_bGood;
+  }
+  
+  bool BufferedFileWriter::close() {
+    bool bSuccess = true;
+    
+    if(m_nFileDescriptor != -1) {
+      bSuccess = this->flush();
+      
+      if(::close(m_nFileDescriptor) != 0) {
+	bSuccess = false;
+      }
+      
+      m_nFileDescriptor = -1;
+      m_bGood = bSuccess && m_bGood;
+    }
+    
+    return bSuccess && m_bGood;
+  }
+  
+  bool BufferedFileWriter::isOpen() {
+    return m_nFileDescriptor != -1;
+  }
+  
+  bool BufferedFileWriter::good() {
+    return m_bGood;
+  }
+  
+  bool BufferedFileWriter::writeThrough(const char* acData, size_t szLength) {
+    while(szLength > 0) {
+      ssize_t sszWritten = ::write(m_nFileDescriptor, acData, szLength);
+      
+      if(sszWritten < 0) {
+	if(errno == EINTR) {
+	  continue;
+	}
+	
+	m_bGood = false;
+	
+	return false;
+      }
+      
+      acData += sszWritten;
+      szLength -= sszWritten;
+      m_ullBytesWritten += sszWritten;
+    }
+    
+    return true;
+  }
+  
+  bool BufferedFileWriter::write(const char* acData, size_t szLength) {
+    if(!m_bGood || m_nFileDescriptor == -1) {
+      return false;
+    }
+    
+    if(m_szBuffered + szLength > m_szBufferSize) {
+      if(!this->flush()) {
+	return false;
+      }
+      
+      if(szLength >= m_szBufferSize) {
+	return this->writeThrough(acData, szLength);
+      }
+    }
+    
+    memcpy(m_acBuffer + m_szBuffered, acData, szLength);
+    m_szBuffered += szLength;
+    
+    return true;
+  }
+  
+  bool BufferedFileWriter::flush() {
+    if(m_szBuffered > 0 && m_bGood) {
+      size_t szBuffered = m_szBuffered;
+      m_szBuffered = 0;
+      
+      return this->writeThrough(m_acBuffer, szBuffered);
+    }
+    
+    return m_bGood;
+  }
+  
+  bool BufferedFileWriter::appendFileContents(std::string strFilename) {
+    if(!m_bGood || m_nFileDescriptor == -1) {
+      return false;
+    }
+    
+    int nSource = ::open(strFilename.c_str(), O_RDONLY);
+    
+    if(nSource == -1) {
+      return false;
+    }
+    
+    bool bSuccess = this->flush();
+    
+    // The (now empty) buffer doubles as the copy buffer.
+    while(bSuccess) {
+      ssize_t sszRead = ::read(nSource, m_acBuffer, m_szBufferSize);
+      
+      if(sszRead < 0) {
+	if(errno == EINTR) {
+	  continue;
+	}
+	
+	bSuccess = false;
+      } else if(sszRead == 0) {
+	break;
+      } else {
+	bSuccess = this->writeThrough(m_acBuffer, sszRead);
+      }
+    }
+    
+    ::close(nSource);
+    
+    return bSuccess;
+  }
+  
+  unsigned long long BufferedFileWriter::bytesWritten() {
+    return m_ullBytesWritten + m_szBuffered;
+  }
+}
@@ -46,10 +46,14 @@ namespace semrec {
       this->setPluginID(createPluginID());
       m_bRunCycle = true;
       m_bDevelopmentPlugin = false;
+      m_bDedicatedCycleThread = false;
+      m_bParallelDispatch = false;
+      m_strDispatchOrderingKey = "";
+      m_bPendingCycleData = false;
+      m_nNextRequestID = 0;
       m_strVersion = "";
       
-      ConfigSettings cfgsetCurrent = configSettings();
-      if(cfgsetCurrent.bOnlyDisplayImportant) {
+      if(configSnapshot()->bOnlyDisplayImportant) {
 	this->setOnlyDisplayImportant(true);
       }
     }
@@ -96,57 +100,136 @@ namespace semrec {
     }
     
     void Plugin::setSubscribedToEvent(std::string strEventName, bool bSubscribed) {
+      if(bSubscribed && !registerEventName(strEventName)) {
+	this->fail("The identifier of event '" + strEventName + "' collides with '" + registeredEventName(eventID(strEventName)) + "'. Not subscribing, rename one of them.");
+	
+	return;
+      }
+      
+      m_mtxSubscriptions.lock();
       m_lstSubscribedEventNames.remove(strEventName);
       
       if(bSubscribed) {
 	m_lstSubscribedEventNames.push_back(strEventName);
       }
+      m_mtxSubscriptions.unlock();
+      
+      invalidateSubscriptionIndex();
     }
     
     bool Plugin::subscribedToEvent(std::string strEventName) {
+      bool bSubscribed = false;
+      
+      m_mtxSubscriptions.lock();
       for(std::string strCurrentName : m_lstSubscribedEventNames) {
 	if(strCurrentName == strEventName) {
-	  return true;
+	  bSubscribed = true;
+	  break;
 	}
       }
+      m_mtxSubscriptions.unlock();
       
-      return false;
+      return bSubscribed;
     }
     
-    void Plugin::consumeEvent(Event evEvent) {
+    std::list<std::string> Plugin::subscribedEventNames() {
+      m_mtxSubscriptions.lock();
+      std::list<std::string> lstEventNames = m_lstSubscribedEventNames;
+      m_mtxSubscriptions.unlock();
+      
+      return lstEventNames;
+    }
+    
+    void Plugin::consumeEvent(const Event& evEvent) {
       // Dummy.
     }
     
     void Plugin::setOffersService(std::string strServiceName, bool bOffering) {
+      if(bOffering && !registerEventName(strServiceName)) {
+	this->fail("The identifier of service '" + strServiceName + "' collides with '" + registeredEventName(eventID(strServiceName)) + "'. Not offering it, rename one of them.");
+	
+	return;
+      }
+      
+      m_mtxSubscriptions.lock();
       m_lstOfferedServices.remove(strServiceName);
       
       if(bOffering) {
 	m_lstOfferedServices.push_back(strServiceName);
       }
+      m_mtxSubscriptions.unlock();
+      
+      invalidateSubscriptionIndex();
     }
     
     bool Plugin::offersService(std::string strServiceName) {
+      bool bOffering = false;
+      
+      m_mtxSubscriptions.lock();
       for(std::string strCurrentName : m_lstOfferedServices) {
 	if(strCurrentName == strServiceName) {
-	  return true;
+	  bOffering = true;
+	  break;
 	}
       }
+      m_mtxSubscriptions.unlock();
       
-      return false;
+      return bOffering;
+    }
+    
+    std::list<std::string> Plugin::offeredServices() {
+      m_mtxSubscriptions.lock();
+      std::list<std::string> lstServices = m_lstOfferedServices;
+      m_mtxSubscriptions.unlock();
+      
+      return lstServices;
     }
     
-    Event Plugin::consumeServiceEvent(ServiceEvent seServiceEvent) {
+    Event Plugin::consumeServiceEvent(const ServiceEvent& seServiceEvent) {
       Event evReturn = defaultEvent();
       
       if(seServiceEvent.siServiceIdentifier == SI_RESPONSE) {
-	m_mtxReceivedServiceEventResponses.lock();
-	m_lstReceivedServiceEventResponses.push_back(seServiceEvent);
-	m_mtxReceivedServiceEventResponses.unlock();
+	m_mtxPendingResponses.lock();
+	
+	// Responses nobody waits for (anymore) are dropped here
+	// instead of piling up.
+	if(seServiceEvent.nRequesterID == this->pluginID() &&
+	   m_setAwaitedServiceEventIDs.erase(seServiceEvent.nServiceEventID) > 0) {
+	  m_mapReceivedServiceEventResponses[seServiceEvent.nServiceEventID] = seServiceEvent;
+	  m_cvPendingResponses.notify_all();
+	}
+	
+	m_mtxPendingResponses.unlock();
       }
       
       return evReturn;
     }
     
+    Event Plugin::dispatchServiceEvent(const ServiceEvent& seServiceEvent) {
+      // Responses go to all plugins; only the requester's own
+      // continuation may pick them up.
+      if(seServiceEvent.siServiceIdentifier == SI_RESPONSE && seServiceEvent.nRequesterID == this->pluginID()) {
+	ResponseHandler rhHandler;
+	
+	m_mtxPendingResponses.lock();
+	std::unordered_map<int, ResponseHandler>::iterator itHandler = m_mapResponseHandlers.find(seServiceEvent.nServiceEventID);
+	
+	if(itHandler != m_mapResponseHandlers.end()) {
+	  rhHandler = std::move(itHandler->second);
+	  m_mapResponseHandlers.erase(itHandler);
+	}
+	m_mtxPendingResponses.unlock();
+	
+	if(rhHandler) {
+	  rhHandler(seServiceEvent);
+	  
+	  return defaultEvent();
+	}
+      }
+      
+      return this->consumeServiceEvent(seServiceEvent);
+    }
+    
     void Plugin::addDependency(std::string strPluginName) {
       m_lstDependencies.remove(strPluginName);
       m_lstDependencies.push_back(strPluginName);
@@ -167,55 +250,109 @@ namespace semrec {
     }
     
     void Plugin::deployCycleData(Result& resDeployTo) {
-      m_mtxEventsStore.lock();
-
-      if(m_lstEvents.size() > 0) {
-	resDeployTo.lstEvents = m_lstEvents;
-	m_lstEvents.clear();
-      }
+      m_mqEvents.drainInto(resDeployTo.lstEvents);
+      m_mqServiceEvents.drainInto(resDeployTo.lstServiceEvents);
+    }
+    
+    void Plugin::notifyPendingCycleData() {
+      m_mtxPendingCycleData.lock();
+      m_bPendingCycleData = true;
+      std::function<void()> fncCycleRequested = m_fncCycleRequested;
+      m_mtxPendingCycleData.unlock();
       
-      m_mtxEventsStore.unlock();
+      m_cvPendingCycleData.notify_one();
       
-      m_mtxServiceEventsStore.lock();
+      if(fncCycleRequested) {
+	fncCycleRequested();
+      }
+    }
+    
+    void Plugin::setCycleRequestHandler(std::function<void()> fncCycleRequested) {
+      m_mtxPendingCycleData.lock();
+      m_fncCycleRequested = fncCycleRequested;
+      m_mtxPendingCycleData.unlock();
+    }
+    
+    bool Plugin::waitForPendingCycleData(float fTimeout) {
+      std::unique_lock<std::mutex> lckPending(m_mtxPendingCycleData);
       
-      if(m_lstServiceEvents.size() > 0) {
-	resDeployTo.lstServiceEvents = m_lstServiceEvents;
-	m_lstServiceEvents.clear();
+      if(!m_bPendingCycleData) {
+	m_cvPendingCycleData.wait_for(lckPending, std::chrono::duration<float>(fTimeout));
       }
       
-      m_mtxServiceEventsStore.unlock();
+      bool bPending = m_bPendingCycleData;
+      m_bPendingCycleData = false;
+      
+      return bPending;
     }
     
-    void Plugin::deployEvent(Event evDeploy, bool bWaitForEvent) {
+    void Plugin::deployEvent(Event evDeploy, bool bWaitForEvent, float fTimeout) {
       evDeploy.nOriginID = this->pluginID();
-      
-      m_mtxEventsStore.lock();
-      m_lstEvents.push_back(evDeploy);
-      m_mtxEventsStore.unlock();
+      evDeploy.eiEventID = eventID(evDeploy.strEventName);
       
       if(bWaitForEvent) {
-	this->waitForEvent(evDeploy);
+	m_mqEvents.push(evDeploy);
+	this->notifyPendingCycleData();
+	
+	this->waitForEvent(evDeploy, fTimeout);
+      } else {
+	m_mqEvents.push(std::move(evDeploy));
+	this->notifyPendingCycleData();
       }
     }
     
-    ServiceEvent Plugin::deployServiceEvent(ServiceEvent seDeploy, bool bWaitForEvent) {
-      seDeploy.nRequesterID = this->pluginID();
+    ServiceEvent Plugin::deployServiceEvent(ServiceEvent seDeploy, bool bWaitForEvent, float fTimeout) {
+      seDeploy.eiServiceID = eventID(seDeploy.strServiceName);
       
+      // Responses keep the ID of the plugin they answer (see
+      // eventInResponseTo).
       if(seDeploy.siServiceIdentifier == SI_REQUEST) {
-	seDeploy.nServiceEventID = rand();
+	seDeploy.nRequesterID = this->pluginID();
+	
+	m_mtxPendingResponses.lock();
+	seDeploy.nServiceEventID = createServiceEventID();
+	
+	// Register before deploying so that an early response isn't
+	// lost.
+	if(bWaitForEvent) {
+	  m_setAwaitedServiceEventIDs.insert(seDeploy.nServiceEventID);
+	}
+	m_mtxPendingResponses.unlock();
       }
       
-      m_mtxServiceEventsStore.lock();
-      m_lstServiceEvents.push_back(seDeploy);
-      m_mtxServiceEventsStore.unlock();
+      m_mqServiceEvents.push(seDeploy);
+      this->notifyPendingCycleData();
       
       if(bWaitForEvent) {
-	return this->waitForEvent(seDeploy);
+	return this->waitForEvent(seDeploy, fTimeout);
       } else {
 	return seDeploy;
       }
     }
     
+    ServiceEvent Plugin::requestService(ServiceEvent seRequest, ResponseHandler rhHandler) {
+      seRequest.nRequesterID = this->pluginID();
+      seRequest.eiServiceID = eventID(seRequest.strServiceName);
+      seRequest.siServiceIdentifier = SI_REQUEST;
+      
+      m_mtxPendingResponses.lock();
+      seRequest.nServiceEventID = createServiceEventID();
+      m_mapResponseHandlers[seRequest.nServiceEventID] = std::move(rhHandler);
+      m_mtxPendingResponses.unlock();
+      
+      m_mqServiceEvents.push(seRequest);
+      this->notifyPendingCycleData();
+      
+      return seRequest;
+    }
+    
+    ServiceEvent Plugin::requestService(std::string strServiceName, Designator* cdDesignator, ResponseHandler rhHandler) {
+      ServiceEvent seRequest = defaultServiceEvent(strServiceName);
+      seRequest.cdDesignator = cdDesignator;
+      
+      return this->requestService(seRequest, std::move(rhHandler));
+    }
+    
     void Plugin::setPluginName(std::string strName) {
       m_strName = strName;
       
@@ -242,45 +379,103 @@ namespace semrec {
       return m_bIsDeprecated;
     }
     
+    void Plugin::setDedicatedCycleThread(bool bDedicatedCycleThread) {
+      m_bDedicatedCycleThread = bDedicatedCycleThread;
+    }
+    
+    bool Plugin::dedicatedCycleThread() {
+      return m_bDedicatedCycleThread;
+    }
+    
+    void Plugin::setParallelDispatch(bool bParallelDispatch) {
+      m_bParallelDispatch = bParallelDispatch;
+    }
+    
+    bool Plugin::parallelDispatch() {
+      return m_bParallelDispatch;
+    }
+    
+    void Plugin::setDispatchOrderingKey(std::string strDispatchOrderingKey) {
+      m_strDispatchOrderingKey = strDispatchOrderingKey;
+    }
+    
+    std::string Plugin::dispatchOrderingKey() {
+      return m_strDispatchOrderingKey;
+    }
+    
     std::string Plugin::pluginIdentifierString(bool bBold) {
       return colorSpecifierForID(this->pluginID(), bBold) +
 	"[" + this->pluginName() + "/" + this->str(this->pluginID()) + "]";
     }
     
-    int Plugin::openNewRequestID() {
-      int nID = 0;
+    int Plugin::nextCorrelationID(int& nCounter) {
+      // NOTE: Must be called with m_mtxPendingResponses
+      // held. IDs are handed out monotonically and only wrap around
+      // after 2^31 requests, skipping the ones still in use; -1
+      // stays reserved for "no request".
+      int nID = nCounter;
       
-      while(this->isRequestIDOpen(nID)) {
-	nID++;
-      }
+      do {
+	nID = (nID == std::numeric_limits<int>::max() ? 0 : nID + 1);
+      } while(m_setOpenRequestIDs.count(nID) > 0);
+      
+      nCounter = nID;
       
-      m_lstOpenRequestIDs.push_back(nID);
+      return nID;
+    }
+    
+    void Plugin::notifyPendingResponses() {
+      // Taking the lock makes sure no waiter is between checking its
+      // condition and going to sleep.
+      m_mtxPendingResponses.lock();
+      m_cvPendingResponses.notify_all();
+      m_mtxPendingResponses.unlock();
+    }
+    
+    int Plugin::openNewRequestID() {
+      m_mtxPendingResponses.lock();
+      int nID = this->nextCorrelationID(m_nNextRequestID);
+      m_setOpenRequestIDs.insert(nID);
+      m_mtxPendingResponses.unlock();
       
       return nID;
     }
     
     bool Plugin::isRequestIDOpen(int nID) {
-      for(int nCurrentID : m_lstOpenRequestIDs) {
-	if(nCurrentID == nID) {
-	  return true;
-	}
-      }
+      m_mtxPendingResponses.lock();
+      bool bOpen = (m_setOpenRequestIDs.count(nID) > 0);
+      m_mtxPendingResponses.unlock();
       
-      return false;
+      return bOpen;
     }
     
     void Plugin::closeRequestID(int nID) {
-      m_lstOpenRequestIDs.remove(nID);
+      m_mtxPendingResponses.lock();
+      
+      if(m_setOpenRequestIDs.erase(nID) > 0) {
+	m_cvPendingResponses.notify_all();
+      }
+      
+      m_mtxPendingResponses.unlock();
     }
     
     bool Plugin::isAnyRequestIDOpen() {
-      return (m_lstOpenRequestIDs.size() > 0);
+      m_mtxPendingResponses.lock();
+      bool bAnyOpen = (m_setOpenRequestIDs.size() > 0);
+      m_mtxPendingResponses.unlock();
+      
+      return bAnyOpen;
     }
     
     void Plugin::setRunning(bool bRunCycle) {
       m_mtxRunCycle.lock();
       m_bRunCycle = bRunCycle;
       m_mtxRunCycle.unlock();
+      
+      // Make sure a sleeping cycle thread and blocked waiters notice
+      // the change
+      this->notifyPendingCycleData();
+      this->notifyPendingResponses();
     }
     
     bool Plugin::running() {
@@ -291,53 +486,77 @@ namespace semrec {
       return bReturn;
     }
     
-    void Plugin::waitForEvent(Event evWait) {
-      if(evWait.nOpenRequestID != -1) {
-	while(this->isRequestIDOpen(evWait.nOpenRequestID) && this->running()) {
-	  // Do nothing and wait.
+    bool Plugin::waitForEvent(Event evWait, float fTimeout) {
+      if(evWait.nOpenRequestID == -1) {
+	return true;
+      }
+      
+      std::chrono::steady_clock::time_point tpDeadline = std::chrono::steady_clock::now() +
+	std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(fTimeout));
+      std::unique_lock<std::mutex> lckPending(m_mtxPendingResponses);
+      
+      while(m_setOpenRequestIDs.count(evWait.nOpenRequestID) > 0 && this->running()) {
+	if(fTimeout <= 0.0) {
+	  m_cvPendingResponses.wait(lckPending);
+	} else if(m_cvPendingResponses.wait_until(lckPending, tpDeadline) == std::cv_status::timeout) {
+	  break;
 	}
       }
+      
+      return (m_setOpenRequestIDs.count(evWait.nOpenRequestID) == 0);
     }
     
-    ServiceEvent Plugin::waitForEvent(ServiceEvent seWait) {
-      bool bGoon = true;
+    ServiceEvent Plugin::waitForEvent(ServiceEvent seWait, float fTimeout) {
       ServiceEvent seReturn = defaultServiceEvent(seWait.strServiceName);
       
-      while(bGoon && this->running()) {
-	m_mtxReceivedServiceEventResponses.lock();
-	
-	for(std::list<ServiceEvent>::iterator itSE = m_lstReceivedServiceEventResponses.begin();
-	    itSE != m_lstReceivedServiceEventResponses.end(); itSE++) {
-	  if(((*itSE).nServiceEventID == seWait.nServiceEventID) && (*itSE).siServiceIdentifier == SI_RESPONSE) {
-	    bGoon = false;
-	    seReturn = *itSE;
-	    
-	    m_lstReceivedServiceEventResponses.erase(itSE);
-	    
-	    break;
-	  }
+      std::chrono::steady_clock::time_point tpDeadline = std::chrono::steady_clock::now() +
+	std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(fTimeout));
+      std::unique_lock<std::mutex> lckPending(m_mtxPendingResponses);
+      std::unordered_map<int, ServiceEvent>::iterator itResponse;
+      
+      while((itResponse = m_mapReceivedServiceEventResponses.find(seWait.nServiceEventID)) == m_mapReceivedServiceEventResponses.end() &&
+	    this->running()) {
+	if(fTimeout <= 0.0) {
+	  m_cvPendingResponses.wait(lckPending);
+	} else if(m_cvPendingResponses.wait_until(lckPending, tpDeadline) == std::cv_status::timeout) {
+	  itResponse = m_mapReceivedServiceEventResponses.find(seWait.nServiceEventID);
+	  break;
 	}
-	
-	m_mtxReceivedServiceEventResponses.unlock();
+      }
+      
+      if(itResponse != m_mapReceivedServiceEventResponses.end()) {
+	seReturn = itResponse->second;
+	m_mapReceivedServiceEventResponses.erase(itResponse);
+      } else {
+	// Gave up; a late response is dropped on arrival.
+	m_setAwaitedServiceEventIDs.erase(seWait.nServiceEventID);
       }
       
       return seReturn;
     }
     
     void Plugin::success(std::string strMessage, bool bImportant) {
-      this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), false, bImportant);
+      if(this->messageEnabled(ML_SUCCESS, bImportant)) {
+	this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), false, bImportant);
+      }
     }
     
     void Plugin::info(std::string strMessage, bool bImportant) {
-      this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), false, bImportant);
+      if(this->messageEnabled(ML_INFO, bImportant)) {
+	this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), false, bImportant);
+      }
     }
     
     void Plugin::warn(std::string strMessage, bool bImportant) {
-      this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), true, bImportant);
+      if(this->messageEnabled(ML_WARN, bImportant)) {
+	this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), true, bImportant);
+      }
     }
     
     void Plugin::fail(std::string strMessage, bool bImportant) {
-      this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), true, bImportant);
+      if(this->messageEnabled(ML_FAIL, bImportant)) {
+	this->coloredText(strMessage, colorSpecifierForID(this->pluginID()), true, bImportant);
+      }
     }
   }
 }
@@ -47,6 +47,10 @@ namespace semrec {
     m_piInstance = NULL;
     m_thrdPluginCycle = NULL;
     m_bRunCycle = true;
+    m_wpExecutor = NULL;
+    m_bCycleScheduled = false;
+    m_bCycleRequested = false;
+    m_fMaxCycleLatency = 0.05;
     m_resCycleResult = defaultResult();
     
     this->setMessagePrefixLabel("plugin-instance");
@@ -154,37 +158,119 @@ namespace semrec {
     return m_piInstance->pluginID();
   }
   
-  Result PluginInstance::cycle() {
-    if(m_thrdPluginCycle == NULL) {
-      m_thrdPluginCycle = new std::thread(&PluginInstance::spinCycle, this);
+  Result PluginInstance::cycle(WorkerPool* wpExecutor) {
+    if(wpExecutor == NULL || m_piInstance->dedicatedCycleThread()) {
+      if(m_thrdPluginCycle == NULL) {
+	m_thrdPluginCycle = new std::thread(&PluginInstance::spinCycle, this);
+      }
+    } else {
+      if(m_wpExecutor == NULL) {
+	m_mtxCycleSchedule.lock();
+	m_wpExecutor = wpExecutor;
+	m_fMaxCycleLatency = configSnapshot()->fMaxCycleLatency;
+	m_tpLastCycle = std::chrono::steady_clock::now();
+	m_mtxCycleSchedule.unlock();
+	
+	m_piInstance->setCycleRequestHandler(std::bind(&PluginInstance::scheduleCycle, this));
+	
+	// The first cycle runs right away, as with a dedicated thread.
+	this->scheduleCycle();
+      } else {
+	// Cycles are scheduled when the plugin deploys data. Plugins
+	// that do periodic work in their `cycle' function also get one
+	// when none ran for `max-cycle-latency' seconds, just like the
+	// dedicated threads' timeout gives them.
+	m_mtxCycleSchedule.lock();
+	std::chrono::duration<float> durIdle = std::chrono::steady_clock::now() - m_tpLastCycle;
+	bool bTick = (!m_bCycleScheduled && durIdle.count() >= m_fMaxCycleLatency);
+	m_mtxCycleSchedule.unlock();
+	
+	if(bTick) {
+	  this->scheduleCycle();
+	}
+      }
     }
     
     return this->currentResult();
   }
   
   void PluginInstance::spinCycle() {
+    float fMaxCycleLatency = configSnapshot()->fMaxCycleLatency;
+    
     while(m_bRunCycle) {
-      Result resCycle = m_piInstance->cycle();
+      // Sleep until the plugin deployed data. The timeout keeps
+      // plugins that do periodic work in their `cycle' function
+      // going.
+      m_piInstance->waitForPendingCycleData(fMaxCycleLatency);
       
-      m_mtxCycleResults.lock();
-      for(Event evCurrent : resCycle.lstEvents) {
-	m_resCycleResult.lstEvents.push_back(evCurrent);
-      }
-      resCycle.lstEvents.clear();
-      
-      for(ServiceEvent seCurrent : resCycle.lstServiceEvents) {
-	m_resCycleResult.lstServiceEvents.push_back(seCurrent);
-      }
-      resCycle.lstServiceEvents.clear();
-      
-      for(StatusMessage smCurrent : resCycle.lstStatusMessages) {
-	m_resCycleResult.lstStatusMessages.push_back(smCurrent);
+      this->runCycleOnce();
+    }
+  }
+  
+  void PluginInstance::scheduleCycle() {
+    m_mtxCycleSchedule.lock();
+    bool bSchedule = false;
+    
+    if(m_bRunCycle && m_wpExecutor) {
+      if(m_bCycleScheduled) {
+	// Run once more after the current cycle, it might already
+	// have collected its data.
+	m_bCycleRequested = true;
+      } else {
+	m_bCycleScheduled = true;
+	bSchedule = true;
       }
-      // TODO(winkler): Maybe there is a `clear` missing here. Check this.
-      
-      m_mtxCycleResults.unlock();
+    }
+    m_mtxCycleSchedule.unlock();
+    
+    if(bSchedule) {
+      m_wpExecutor->enqueue(std::bind(&PluginInstance::runScheduledCycle, this));
+    }
+  }
+  
+  void PluginInstance::runScheduledCycle() {
+    m_mtxCycleSchedule.lock();
+    bool bRun = m_bRunCycle;
+    m_bCycleRequested = false;
+    m_mtxCycleSchedule.unlock();
+    
+    if(bRun) {
+      this->runCycleOnce();
+    }
+    
+    m_mtxCycleSchedule.lock();
+    m_tpLastCycle = std::chrono::steady_clock::now();
+    
+    if(m_bCycleRequested && m_bRunCycle) {
+      // Requeue instead of looping, so other tasks get their turn.
+      m_mtxCycleSchedule.unlock();
+      m_wpExecutor->enqueue(std::bind(&PluginInstance::runScheduledCycle, this));
+    } else {
+      m_bCycleScheduled = false;
       
-      usleep(10);
+      // Notify while still holding the lock: once a waiter sees the
+      // flag cleared, this instance may be destroyed.
+      m_cvCycleSchedule.notify_all();
+      m_mtxCycleSchedule.unlock();
+    }
+  }
+  
+  void PluginInstance::runCycleOnce() {
+    Result resCycle = m_piInstance->cycle();
+    bool bHasData = (resCycle.lstEvents.size() > 0 ||
+		     resCycle.lstServiceEvents.size() > 0 ||
+		     resCycle.lstStatusMessages.size() > 0);
+    
+    // Splicing moves the list nodes over, so the lock is only held
+    // for constant time.
+    m_mtxCycleResults.lock();
+    m_resCycleResult.lstEvents.splice(m_resCycleResult.lstEvents.end(), resCycle.lstEvents);
+    m_resCycleResult.lstServiceEvents.splice(m_resCycleResult.lstServiceEvents.end(), resCycle.lstServiceEvents);
+    m_resCycleResult.lstStatusMessages.splice(m_resCycleResult.lstStatusMessages.end(), resCycle.lstStatusMessages);
+    m_mtxCycleResults.unlock();
+    
+    if(bHasData) {
+      notifyCoreWakeup();
     }
   }
   
@@ -196,7 +282,11 @@ namespace semrec {
     return m_piInstance->subscribedToEvent(strEventName);
   }
   
-  void PluginInstance::consumeEvent(Event evEvent) {
+  std::list<std::string> PluginInstance::subscribedEventNames() {
+    return m_piInstance->subscribedEventNames();
+  }
+  
+  void PluginInstance::consumeEvent(const Event& evEvent) {
     m_piInstance->consumeEvent(evEvent);
   }
   
@@ -204,8 +294,60 @@ namespace semrec {
     return m_piInstance->offersService(strServiceName);
   }
   
-  Event PluginInstance::consumeServiceEvent(ServiceEvent seServiceEvent) {
-    return m_piInstance->consumeServiceEvent(seServiceEvent);
+  std::list<std::string> PluginInstance::offeredServices() {
+    return m_piInstance->offeredServices();
+  }
+  
+  Event PluginInstance::consumeServiceEvent(const ServiceEvent& seServiceEvent) {
+    return m_piInstance->dispatchServiceEvent(seServiceEvent);
+  }
+  
+  bool PluginInstance::parallelDispatch() {
+    return m_piInstance->parallelDispatch();
+  }
+  
+  std::string PluginInstance::dispatchOrderingKey() {
+    return m_piInstance->dispatchOrderingKey();
+  }
+  
+  void PluginInstance::queueEvent(const Event& evEvent, WorkerStrand* wsStrand) {
+    Event evQueued = evEvent;
+    
+    if(evQueued.cdDesignator) {
+      evQueued.cdDesignator = new Designator(evEvent.cdDesignator);
+    }
+    
+    wsStrand->enqueue(std::bind(&PluginInstance::deliverEvent, this, std::move(evQueued)));
+  }
+  
+  void PluginInstance::queueServiceEvent(const ServiceEvent& seServiceEvent, WorkerStrand* wsStrand) {
+    ServiceEvent seQueued = seServiceEvent;
+    bool bOwnsDesignator = false;
+    
+    // Preserved designators are owned by their creator and outlive
+    // the dispatch; all others are deleted by the core.
+    if(seQueued.cdDesignator && !seQueued.bPreserve) {
+      seQueued.cdDesignator = new Designator(seServiceEvent.cdDesignator);
+      bOwnsDesignator = true;
+    }
+    
+    wsStrand->enqueue(std::bind(&PluginInstance::deliverServiceEvent, this, std::move(seQueued), bOwnsDesignator));
+  }
+  
+  void PluginInstance::deliverEvent(Event evEvent) {
+    m_piInstance->consumeEvent(evEvent);
+    
+    if(evEvent.cdDesignator) {
+      delete evEvent.cdDesignator;
+    }
+  }
+  
+  void PluginInstance::deliverServiceEvent(ServiceEvent seServiceEvent, bool bOwnsDesignator) {
+    m_piInstance->dispatchServiceEvent(seServiceEvent);
+    
+    if(bOwnsDesignator) {
+      delete seServiceEvent.cdDesignator;
+    }
   }
   
   std::string PluginInstance::name() {
@@ -215,23 +357,37 @@ namespace semrec {
   Result PluginInstance::currentResult() {
     Result resReturn = defaultResult();
     
-    if(m_mtxCycleResults.try_lock()) {
-      resReturn = m_resCycleResult;
-      m_resCycleResult = defaultResult();
-      m_mtxCycleResults.unlock();
-    }
+    // NOTE: This used to be a `try_lock', skipping the
+    // plugin's output for a cycle under contention. The cycle thread
+    // only holds the lock for a few splices now, so just wait for it.
+    m_mtxCycleResults.lock();
+    resReturn.lstEvents.swap(m_resCycleResult.lstEvents);
+    resReturn.lstServiceEvents.swap(m_resCycleResult.lstServiceEvents);
+    resReturn.lstStatusMessages.swap(m_resCycleResult.lstStatusMessages);
+    m_mtxCycleResults.unlock();
     
     return resReturn;
   }
   
   void PluginInstance::setRunning(bool bRunCycle) {
+    m_mtxCycleSchedule.lock();
     m_bRunCycle = bRunCycle;
+    m_mtxCycleSchedule.unlock();
     
     m_piInstance->setRunning(bRunCycle);
   }
   
   void PluginInstance::waitForJoin() {
-    m_thrdPluginCycle->join();
-    delete m_thrdPluginCycle;
+    if(m_thrdPluginCycle) {
+      m_thrdPluginCycle->join();
+      delete m_thrdPluginCycle;
+      m_thrdPluginCycle = NULL;
+    }
+    
+    std::unique_lock<std::mutex> lckCycleSchedule(m_mtxCycleSchedule);
+    
+    while(m_bCycleScheduled) {
+      m_cvCycleSchedule.wait(lckCycleSchedule);
+    }
   }
 }
@@ -44,11 +44,24 @@ namespace semrec {
   PluginSystem::PluginSystem(int argc, char** argv) {
     m_argc = argc;
     m_argv = argv;
+    m_wpExecutor = NULL;
+    m_bParallelDispatch = false;
+    m_bSubscriptionIndexValid = false;
+    m_unSubscriptionIndexGeneration = 0;
     
     this->setMessagePrefixLabel("plugins");
   }
   
   PluginSystem::~PluginSystem() {
+    // Finish all parallel deliveries before plugins go away
+    this->waitForDispatch();
+    
+    for(std::pair<const std::string, WorkerStrand*>& prStrand : m_mapDispatchStrands) {
+      delete prStrand.second;
+    }
+    
+    m_mapDispatchStrands.clear();
+    
     m_lstLoadedPlugins.reverse();
     
     // Trigger kill signals
@@ -56,11 +69,16 @@ namespace semrec {
       icCurrent->setRunning(false);
     }
     
-    // Join all threads
+    // Join all threads and wait for running cycle tasks
     for(PluginInstance* icCurrent : m_lstLoadedPlugins) {
       icCurrent->waitForJoin();
     }
     
+    if(m_wpExecutor) {
+      m_wpExecutor->shutdown();
+      delete m_wpExecutor;
+    }
+    
     // Delete all structures
     for(PluginInstance* icCurrent : m_lstLoadedPlugins) {
       icCurrent->unload();
@@ -111,6 +129,57 @@ namespace semrec {
     return m_bLoadDevelopmentPlugins;
   }
   
+  void PluginSystem::setWorkerThreads(unsigned int unThreads) {
+    if(m_wpExecutor) {
+      // NOTE: Plugins hold on to the executor once they
+      // cycled, so it can only be replaced before that.
+      this->warn("The plugin executor was already set up, not resizing it.");
+    } else {
+      if(unThreads == 0) {
+	unThreads = std::thread::hardware_concurrency();
+      }
+      
+      m_wpExecutor = new WorkerPool(unThreads);
+      this->info("Running plugins on " + this->str((int)m_wpExecutor->threadCount()) + " executor thread(s)");
+    }
+  }
+  
+  void PluginSystem::setParallelDispatch(bool bParallelDispatch) {
+    m_bParallelDispatch = bParallelDispatch;
+    
+    if(m_bParallelDispatch) {
+      this->info("Delivering events in parallel to plugins that support it");
+    }
+  }
+  
+  WorkerStrand* PluginSystem::dispatchStrand(PluginInstance* piPlugin) {
+    if(!m_bParallelDispatch || !m_wpExecutor || !piPlugin->parallelDispatch()) {
+      return NULL;
+    }
+    
+    // Plugin names can't contain `/', so they don't collide with
+    // ordering keys chosen by plugins.
+    std::string strKey = piPlugin->dispatchOrderingKey();
+    
+    if(strKey == "") {
+      strKey = "/" + piPlugin->name();
+    }
+    
+    WorkerStrand*& wsStrand = m_mapDispatchStrands[strKey];
+    
+    if(!wsStrand) {
+      wsStrand = new WorkerStrand(m_wpExecutor);
+    }
+    
+    return wsStrand;
+  }
+  
+  void PluginSystem::waitForDispatch() {
+    for(std::pair<const std::string, WorkerStrand*>& prStrand : m_mapDispatchStrands) {
+      prStrand.second->wait();
+    }
+  }
+  
   bool PluginSystem::pluginFailedToLoadBefore(std::string strName) {
     for(std::string strPluginName : m_lstLoadFailedPlugins) {
       if(strPluginName == strName) {
@@ -185,6 +254,7 @@ namespace semrec {
 	      
 	      if(rsResult.bSuccess) {
 		m_lstLoadedPlugins.push_back(icLoad);
+		m_bSubscriptionIndexValid = false;
 	      } else {
 		resLoad.bSuccess = false;
 		resLoad.riResultIdentifier = RI_PLUGIN_LOADING_FAILED;
@@ -224,12 +294,65 @@ namespace semrec {
     m_lstUnloadPlugins.push_back(icUnload);
   }
   
-  int PluginSystem::spreadEvent(Event evEvent) {
+  void PluginSystem::ensureSubscriptionIndex() {
+    // NOTE: Plugins may change their subscriptions at any
+    // time (and from any thread). Each change bumps a global
+    // generation counter, so checking it here is a single atomic
+    // load per dispatched event. The generation is read before the
+    // plugins' lists, so a change that happens during the rebuild
+    // triggers another rebuild on the next dispatch.
+    unsigned long unGeneration = subscriptionIndexGeneration();
+    
+    if(!m_bSubscriptionIndexValid || unGeneration != m_unSubscriptionIndexGeneration) {
+      m_mapEventSubscribers.clear();
+      m_mapServiceProviders.clear();
+      
+      for(PluginInstance* piPlugin : m_lstLoadedPlugins) {
+	for(std::string strEventName : piPlugin->subscribedEventNames()) {
+	  // Subscriptions with colliding identifiers are rejected
+	  // (see Plugin::setSubscribedToEvent), so all plugins in an
+	  // entry subscribed to the same name.
+	  IndexEntry& ieEntry = m_mapEventSubscribers[eventID(strEventName)];
+	  ieEntry.strName = strEventName;
+	  ieEntry.vecPlugins.push_back(piPlugin);
+	}
+	
+	for(std::string strServiceName : piPlugin->offeredServices()) {
+	  IndexEntry& ieEntry = m_mapServiceProviders[eventID(strServiceName)];
+	  ieEntry.strName = strServiceName;
+	  ieEntry.vecPlugins.push_back(piPlugin);
+	}
+      }
+      
+      m_unSubscriptionIndexGeneration = unGeneration;
+      m_bSubscriptionIndexValid = true;
+    }
+  }
+  
+  int PluginSystem::spreadEvent(const Event& evEvent) {
     int nReceivers = 0;
     
-    for(PluginInstance* piPlugin : m_lstLoadedPlugins) {
-      if(piPlugin->subscribedToEvent(evEvent.strEventName)) {
-	piPlugin->consumeEvent(evEvent);
+    this->ensureSubscriptionIndex();
+    
+    std::unordered_map<EventID, IndexEntry>::iterator itSubscribers = m_mapEventSubscribers.find(evEvent.eiEventID);
+    
+    // Event names created at runtime (for example forwarded alter
+    // commands) never went through the subscription collision check,
+    // so a matching identifier alone doesn't mean a matching name.
+    if(itSubscribers != m_mapEventSubscribers.end() && itSubscribers->second.strName == evEvent.strEventName) {
+      // Copy the receivers, as consuming the event might change
+      // subscriptions and with that, the index.
+      std::vector<PluginInstance*> vecReceivers = itSubscribers->second.vecPlugins;
+      
+      for(PluginInstance* piPlugin : vecReceivers) {
+	WorkerStrand* wsStrand = this->dispatchStrand(piPlugin);
+	
+	if(wsStrand) {
+	  piPlugin->queueEvent(evEvent, wsStrand);
+	} else {
+	  piPlugin->consumeEvent(evEvent);
+	}
+	
 	nReceivers++;
       }
     }
@@ -237,36 +360,72 @@ namespace semrec {
     return nReceivers;
   }
   
-  int PluginSystem::spreadServiceEvent(ServiceEvent seServiceEvent) {
+  int PluginSystem::spreadServiceEvent(const ServiceEvent& seServiceEvent) {
     std::list<Event> lstResultEvents;
     int nReceivers = 0;
     
-    for(PluginInstance* piPlugin : m_lstLoadedPlugins) {
-      if(piPlugin->offersService(seServiceEvent.strServiceName) ||
-	 seServiceEvent.siServiceIdentifier == SI_RESPONSE) {
-	Event evResult = piPlugin->consumeServiceEvent(seServiceEvent);
-	nReceivers++;
+    // Responses go to all plugins; requests only to the plugins
+    // offering the requested service.
+    std::vector<PluginInstance*> vecReceivers;
+    
+    if(seServiceEvent.siServiceIdentifier == SI_RESPONSE) {
+      vecReceivers.assign(m_lstLoadedPlugins.begin(), m_lstLoadedPlugins.end());
+    } else {
+      this->ensureSubscriptionIndex();
+      
+      std::unordered_map<EventID, IndexEntry>::iterator itProviders = m_mapServiceProviders.find(seServiceEvent.eiServiceID);
+      
+      if(itProviders != m_mapServiceProviders.end() && itProviders->second.strName == seServiceEvent.strServiceName) {
+	vecReceivers = itProviders->second.vecPlugins;
+      }
+    }
+    
+    for(PluginInstance* piPlugin : vecReceivers) {
+      Event evResult = defaultEvent();
+      WorkerStrand* wsStrand = NULL;
+      
+      if(seServiceEvent.siServiceIdentifier == SI_RESPONSE) {
+	// Results of responses aren't used, so they can be delivered
+	// in parallel.
+	wsStrand = this->dispatchStrand(piPlugin);
+      }
+      
+      if(wsStrand) {
+	piPlugin->queueServiceEvent(seServiceEvent, wsStrand);
+      } else {
+	evResult = piPlugin->consumeServiceEvent(seServiceEvent);
+      }
+      
+      nReceivers++;
+      
+      if(seServiceEvent.smResultModifier != SM_IGNORE_RESULTS) {
+	evResult.nOriginID = piPlugin->pluginID();
+	lstResultEvents.push_back(evResult);
 	
-	if(seServiceEvent.smResultModifier != SM_IGNORE_RESULTS) {
-	  evResult.nOriginID = piPlugin->pluginID();
-	  lstResultEvents.push_back(evResult);
-	  
-	  if(seServiceEvent.smResultModifier == SM_FIRST_RESULT) {
-	    break;
-	  } else {
-	    // Aggregate results
-	  }
+	if(seServiceEvent.smResultModifier == SM_FIRST_RESULT) {
+	  break;
+	} else {
+	  // Aggregate results
 	}
       }
     }
     
     PluginInstance* piRequester = this->pluginInstanceByID(seServiceEvent.nRequesterID);
-    if(piRequester && seServiceEvent.smResultModifier != SM_IGNORE_RESULTS) {
+    if(piRequester && seServiceEvent.siServiceIdentifier == SI_REQUEST && seServiceEvent.smResultModifier != SM_IGNORE_RESULTS) {
       ServiceEvent seResponses = seServiceEvent;
-      seResponses.lstResultEvents = lstResultEvents;
+      seResponses.lstResultEvents = std::move(lstResultEvents);
       seResponses.siServiceIdentifier = SI_RESPONSE;
       
-      piRequester->consumeServiceEvent(seResponses);
+      // The requester's result is discarded, so its response (and
+      // with it, the continuation waiting for it) can be delivered
+      // in parallel, for example exporters writing out a plan tree.
+      WorkerStrand* wsStrand = this->dispatchStrand(piRequester);
+      
+      if(wsStrand) {
+	piRequester->queueServiceEvent(seResponses, wsStrand);
+      } else {
+	piRequester->consumeServiceEvent(seResponses);
+      }
     }
     
     return nReceivers;
@@ -276,11 +435,9 @@ namespace semrec {
     Result resCycle = defaultResult();
     
     for(PluginInstance* icCurrent : m_lstLoadedPlugins) {
-      Result resCurrent = icCurrent->cycle();
+      Result resCurrent = icCurrent->cycle(m_wpExecutor);
       
-      for(StatusMessage smCurrent : resCurrent.lstStatusMessages) {
-	resCycle.lstStatusMessages.push_back(smCurrent);
-      }
+      resCycle.lstStatusMessages.splice(resCycle.lstStatusMessages.end(), resCurrent.lstStatusMessages);
       
       if(resCurrent.bSuccess == false) {
 	// NOTE(winkler): This might also be a good place to implement
@@ -289,22 +446,28 @@ namespace semrec {
 	// plugins (in order of dependency) to "recover".
 	this->queueUnloadPluginInstance(icCurrent);
       } else {
-	for(Event evtCurrent : resCurrent.lstEvents) {
-	  resCycle.lstEvents.push_back(evtCurrent);
-	}
-	
-	for(ServiceEvent seCurrent : resCurrent.lstServiceEvents) {
-	  resCycle.lstServiceEvents.push_back(seCurrent);
-	}
+	resCycle.lstEvents.splice(resCycle.lstEvents.end(), resCurrent.lstEvents);
+	resCycle.lstServiceEvents.splice(resCycle.lstServiceEvents.end(), resCurrent.lstServiceEvents);
       }
     }
     
+    if(m_lstUnloadPlugins.size() > 0) {
+      // Queued deliveries refer to the plugins
+      this->waitForDispatch();
+    }
+    
     for(PluginInstance* icCurrent : m_lstUnloadPlugins) {
+      icCurrent->setRunning(false);
+      icCurrent->waitForJoin();
       icCurrent->unload();
       m_lstLoadedPlugins.remove(icCurrent);
       delete icCurrent;
+      
+      m_bSubscriptionIndexValid = false;
     }
     
+    m_lstUnloadPlugins.clear();
+    
     return resCycle;
   }
   
@@ -41,6 +41,14 @@
 
 
 namespace semrec {
+  static bool eventSequenceLess(const Event& evFirst, const Event& evSecond) {
+    return evFirst.nSequenceNumber < evSecond.nSequenceNumber;
+  }
+  
+  static bool serviceEventSequenceLess(const ServiceEvent& seFirst, const ServiceEvent& seSecond) {
+    return seFirst.nSequenceNumber < seSecond.nSequenceNumber;
+  }
+  
   SemanticHierarchyRecorder::SemanticHierarchyRecorder(int argc, char** argv) {
     m_psPlugins = NULL;
     m_bRun = true;
@@ -110,13 +118,15 @@ namespace semrec {
       
       this->info("Loading plugins: " + strPlugins);
       
-      // Messages are distributed through the event system from now
-      // on.
-      this->setRedirectOutput(true);
+      // Messages are written by the background message sink from
+      // now on, so they never hold up the event cycle.
+      messageSink().start();
       
       // Set the global PluginSystem settings.
       ConfigSettings cfgsetCurrent = configSettings();
       m_psPlugins->setLoadDevelopmentPlugins(cfgsetCurrent.bLoadDevelopmentPlugins);
+      m_psPlugins->setWorkerThreads(cfgsetCurrent.nWorkerThreads);
+      m_psPlugins->setParallelDispatch(cfgsetCurrent.bParallelDispatch);
       
       // Set the settings concerning MongoDB, and experiment name mask
       // for each plugin here (through PluginSystem).
@@ -159,6 +169,13 @@ namespace semrec {
       delete m_psPlugins;
     }
     
+    unsigned long ulDropped = messageSink().droppedMessages();
+    if(ulDropped > 0) {
+      this->warn("Dropped " + this->str((int)ulDropped) + " status message(s) due to a full message buffer.");
+    }
+    
+    messageSink().stop();
+    
     return resInit;
   }
   
@@ -175,6 +192,9 @@ namespace semrec {
 	// afterwards that might use the ${WORKSPACE} token.
 	bool bDisplayUnhandledEvents = true;
 	bool bDisplayUnhandledServiceEvents = true;
+	float fMaxCycleLatency = 0.05;
+	int nWorkerThreads = 0;
+	bool bParallelDispatch = false;
 	m_bOnlyDisplayImportant = false;
 	
 	if(cfgConfig.exists("miscellaneous")) {
@@ -193,7 +213,47 @@ namespace semrec {
 	  sMiscellaneous.lookupValue("display-unhandled-service-events", bDisplayUnhandledServiceEvents);
 	  sMiscellaneous.lookupValue("command-line-output", m_bCommandLineOutput);
 	  sMiscellaneous.lookupValue("only-display-important-messages", m_bOnlyDisplayImportant);
+	  
+	  std::string strMinimumMessageLevel = "";
+	  if(sMiscellaneous.lookupValue("minimum-message-level", strMinimumMessageLevel)) {
+	    MessageLevel mlMinimum;
+	    
+	    if(this->messageLevelFromString(strMinimumMessageLevel, mlMinimum)) {
+	      this->setMinimumMessageLevel(mlMinimum);
+	    } else {
+	      this->warn("Unknown minimum message level '" + strMinimumMessageLevel + "', showing all messages.");
+	    }
+	  }
 	  sMiscellaneous.lookupValue("display-configuration-details", m_bDisplayConfigurationDetails);
+	  sMiscellaneous.lookupValue("max-cycle-latency", fMaxCycleLatency);
+	  sMiscellaneous.lookupValue("worker-threads", nWorkerThreads);
+	  sMiscellaneous.lookupValue("parallel-dispatch", bParallelDispatch);
+	  
+	  int nMessageBufferSize = 1024;
+	  if(sMiscellaneous.lookupValue("message-buffer-size", nMessageBufferSize)) {
+	    if(nMessageBufferSize > 0) {
+	      messageSink().setCapacity(nMessageBufferSize);
+	    } else {
+	      this->warn("The message buffer size must be positive. Keeping " + this->str((int)messageSink().capacity()) + ".");
+	    }
+	  }
+	  
+	  std::string strMessageOverflowPolicy = "";
+	  if(sMiscellaneous.lookupValue("message-overflow-policy", strMessageOverflowPolicy)) {
+	    if(strMessageOverflowPolicy == "drop") {
+	      messageSink().setOverflowPolicy(MessageSink::OP_DROP);
+	    } else if(strMessageOverflowPolicy == "block") {
+	      messageSink().setOverflowPolicy(MessageSink::OP_BLOCK);
+	    } else {
+	      this->warn("Unknown message overflow policy '" + strMessageOverflowPolicy + "', defaulting to 'block'.");
+	      messageSink().setOverflowPolicy(MessageSink::OP_BLOCK);
+	    }
+	  }
+	  
+	  if(fMaxCycleLatency <= 0.0) {
+	    this->warn("The maximum cycle latency must be positive. Defaulting to 0.05 seconds.");
+	    fMaxCycleLatency = 0.05;
+	  }
 	  
 	  if(!m_bCommandLineOutput) {
 	    this->setRedirectOutput(true);
@@ -418,6 +478,9 @@ namespace semrec {
 	cfgsetCurrent.bDisplayUnhandledServiceEvents = bDisplayUnhandledServiceEvents;
 	cfgsetCurrent.vecPluginOutputColors = vecPluginOutputColors;
 	cfgsetCurrent.bOnlyDisplayImportant = m_bOnlyDisplayImportant;
+	cfgsetCurrent.fMaxCycleLatency = fMaxCycleLatency;
+	cfgsetCurrent.nWorkerThreads = (nWorkerThreads > 0 ? nWorkerThreads : 0);
+	cfgsetCurrent.bParallelDispatch = bParallelDispatch;
 	setConfigSettings(cfgsetCurrent);
 	
 	return true;
@@ -541,10 +604,9 @@ namespace semrec {
     return true;
   }
   
-  bool SemanticHierarchyRecorder::spreadEvent(Event evEvent) {
+  bool SemanticHierarchyRecorder::spreadEvent(const Event& evEvent) {
     if(m_psPlugins->spreadEvent(evEvent) == 0) {
-      ConfigSettings cfgSet = configSettings();
-      if(cfgSet.bDisplayUnhandledEvents) {
+      if(configSnapshot()->bDisplayUnhandledEvents) {
 	this->warn("Unhandled event dropped: '" + evEvent.strEventName + "'");
 	
 	if(evEvent.cdDesignator) {
@@ -565,13 +627,11 @@ namespace semrec {
     return true; // Event was received by some entity (e.g. plugin)
   }
   
-  void SemanticHierarchyRecorder::spreadServiceEvent(ServiceEvent seServiceEvent) {
+  void SemanticHierarchyRecorder::spreadServiceEvent(const ServiceEvent& seServiceEvent) {
     if(m_psPlugins->spreadServiceEvent(seServiceEvent) == 0) {
       // The service event wasn't handled (i.e. there was no valid
       // receiver for it).
-      ConfigSettings cfgSet = configSettings();
-      
-      if(cfgSet.bDisplayUnhandledServiceEvents) {
+      if(configSnapshot()->bDisplayUnhandledServiceEvents) {
 	this->warn("Unhandled service event ('" + seServiceEvent.strServiceName + "') dropped.");
 	
 	if(seServiceEvent.cdDesignator) {
@@ -595,30 +655,14 @@ namespace semrec {
     if(m_bRun) {
       Result resCycle = m_psPlugins->cycle();
       
-      // Forward all status messages collected from the plugins and
-      // the core into the event system
-      std::list<StatusMessage> lstCoreMessages = queuedMessages();
-      for(StatusMessage smCurrent : lstCoreMessages) {
-	resCycle.lstStatusMessages.push_back(smCurrent);
-      }
-      
-      for(StatusMessage smCurrent : resCycle.lstStatusMessages) {
-	Event evEvent = defaultEvent("status-message");
-	evEvent.msgStatusMessage = smCurrent;
-	evEvent.bPreempt = false;
-	
-	if(this->spreadEvent(evEvent)) {
-	  this->setRedirectOutput(true);
-	}
-      }
-      
-      for(Event evtCurrent : m_lstGlobalEvents) {
-	resCycle.lstEvents.push_back(evtCurrent);
+      // Status messages reported through plugin results go to the
+      // message sink like all others; they are not part of the
+      // event system.
+      for(const StatusMessage& smCurrent : resCycle.lstStatusMessages) {
+	queueMessage(smCurrent);
       }
       
-      if(m_lstGlobalEvents.size() > 0) {
-	m_lstGlobalEvents.clear();
-      }
+      resCycle.lstEvents.splice(resCycle.lstEvents.end(), m_lstGlobalEvents);
       
       if(resCycle.bSuccess) {
 	// NOTE(winkler): (Service)Event distribution was done in a
@@ -633,90 +677,50 @@ namespace semrec {
 	// measure was taken to prevent race conditions, which came up
 	// due to fast, but ordered messages from outside.
 	
-	// While there are events in either list, look for the lowest
-	// one.
-	while(resCycle.lstEvents.size() > 0 || resCycle.lstServiceEvents.size() > 0) {
-	  // Identify the next highest (i.e. at the moment lowest)
-	  // sequence number
-	  int nSequenceNumber = 100000; // Dirty: Don't put more than
-					// 100000 msgs in the queue at
-					// the same time, or the
-					// system will deadlock.
-	  
-	  // In Events
-	  for(Event evEvent : resCycle.lstEvents) {
-	    if(evEvent.nSequenceNumber < nSequenceNumber) {
-	      nSequenceNumber = evEvent.nSequenceNumber;
-	    }
-	  }
-	  
-	  // In ServiceEvents
-	  for(ServiceEvent seEvent : resCycle.lstServiceEvents) {
-	    if(seEvent.nSequenceNumber < nSequenceNumber) {
-	      nSequenceNumber = seEvent.nSequenceNumber;
-	    }
-	  }
-	  
-	  // Spread the respective (Service)Event
-	  bool bWasSpread = false;
-	  
-	  for(std::list<Event>::iterator itEvent = resCycle.lstEvents.begin();
-	      itEvent != resCycle.lstEvents.end(); itEvent++) {
-	    Event evEvent = *itEvent;
+	// Both lists are concatenations of the already ordered
+	// per-plugin queues. Sort them once (std::list::sort is a
+	// stable merge sort) and then merge the two ordered lists
+	// while dispatching, which keeps a cycle at O(n log n)
+	// instead of rescanning both lists for every single item. On
+	// equal sequence numbers, Events go before ServiceEvents.
+	resCycle.lstEvents.sort(eventSequenceLess);
+	resCycle.lstServiceEvents.sort(serviceEventSequenceLess);
+	
+	std::list<Event>::iterator itEvent = resCycle.lstEvents.begin();
+	std::list<ServiceEvent>::iterator itServiceEvent = resCycle.lstServiceEvents.begin();
+	
+	while(itEvent != resCycle.lstEvents.end() || itServiceEvent != resCycle.lstServiceEvents.end()) {
+	  bool bSpreadEvent = (itServiceEvent == resCycle.lstServiceEvents.end() ||
+			       (itEvent != resCycle.lstEvents.end() &&
+				itEvent->nSequenceNumber <= itServiceEvent->nSequenceNumber));
+	  
+	  if(bSpreadEvent) {
+	    // Distribute the event
+	    this->spreadEvent(*itEvent);
 	    
-	    if(evEvent.nSequenceNumber == nSequenceNumber) {
-	      // Distribute the event
-	      this->spreadEvent(evEvent);
-	      
-	      // Clean up
-	      if(evEvent.cdDesignator) {
-		delete evEvent.cdDesignator;
-	      }
-	      
-	      resCycle.lstEvents.erase(itEvent);
-	      
-	      nSequenceNumber = evEvent.nSequenceNumber;
-	      bWasSpread = true;
-	      
-	      break;
+	    // Clean up
+	    if(itEvent->cdDesignator) {
+	      delete itEvent->cdDesignator;
 	    }
-	  }
-	  
-	  if(!bWasSpread) {
-	    for(std::list<ServiceEvent>::iterator itEvent = resCycle.lstServiceEvents.begin();
-		itEvent != resCycle.lstServiceEvents.end(); itEvent++) {
-	      ServiceEvent seEvent = *itEvent;
-	      
-	      if(seEvent.nSequenceNumber == nSequenceNumber) {
-		// Distribute the event
-		this->spreadServiceEvent(seEvent);
-		
-		// Clean up
-		if(seEvent.cdDesignator) {
-		  if(!seEvent.bPreserve) {
-		    delete seEvent.cdDesignator;
-		  }
-		}
-		
-		resCycle.lstServiceEvents.erase(itEvent);
-		
-		nSequenceNumber = seEvent.nSequenceNumber;
-		bWasSpread = true;
-		
-		break;
+	    
+	    itEvent++;
+	  } else {
+	    // Distribute the service event
+	    this->spreadServiceEvent(*itServiceEvent);
+	    
+	    // Clean up
+	    if(itServiceEvent->cdDesignator) {
+	      if(!itServiceEvent->bPreserve) {
+		delete itServiceEvent->cdDesignator;
 	      }
 	    }
-	  }
-	  
-	  if(!bWasSpread) {
-	    // This should __never_ever__ happen. The sequence number
-	    // we found before wasn't found again. This means either
-	    // binary or memory corruption.
-	    this->fail("Sequence number hazard! Restart and possibly recompile.");
+	    
+	    itServiceEvent++;
 	  }
 	}
 	
-	resetSequenceNumbers();
+	resCycle.lstEvents.clear();
+	resCycle.lstServiceEvents.clear();
 	
 	// Special events
 	m_mtxTerminalResize.lock();
@@ -732,14 +736,8 @@ namespace semrec {
     } else {
       bContinue = false;
       
-      // Last shot for the unhandled messages
-      std::list<StatusMessage> lstCoreMessages = queuedMessages();
-      for(StatusMessage smCurrent : lstCoreMessages) {
-	Event evMessage = defaultEvent("status-message");
-	evMessage.msgStatusMessage = smCurrent;
-	
-	this->handleUnhandledEvent(evMessage);
-      }
+      // Write out everything that was logged up to now
+      messageSink().flush();
       
       // Send the shutdown message
       m_lstGlobalEvents.push_back(defaultEvent("shutdown"));
@@ -765,8 +763,7 @@ namespace semrec {
   }
   
   std::string SemanticHierarchyRecorder::baseDataDirectory() {
-    ConfigSettings cfgsetCurrent = configSettings();
-    return cfgsetCurrent.strBaseDataDirectory;
+    return configSnapshot()->strBaseDataDirectory;
   }
   
   std::list<std::string> SemanticHierarchyRecorder::workspaceDirectories() {
@@ -869,19 +866,10 @@ namespace semrec {
     return lstReplacements;
   }
   
-  bool SemanticHierarchyRecorder::handleUnhandledEvent(Event evEvent) {
-    if(evEvent.strEventName == "status-message") {
-      StatusMessage msgStatus = evEvent.msgStatusMessage;
-      
-      if(m_bCommandLineOutput) {
-	this->setRedirectOutput(false);
-      } else {
-	this->setRedirectOutput(true);
-      }
-      
-      return true;
-    }
-    
+  bool SemanticHierarchyRecorder::handleUnhandledEvent(const Event& evEvent) {
+    // NOTE: Status messages used to end up here. They are
+    // handled by the message sink now; no other event has a
+    // fallback handler.
     return false;
   }
   
@@ -0,0 +1,100 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <semrec/UniqueIDGenerator.h>
+
+
+namespace semrec {
+  UniqueIDGenerator::UniqueIDGenerator() {
+    this->reset();
+  }
+  
+  UniqueIDGenerator::~UniqueIDGenerator() {
+  }
+  
+  char UniqueIDGenerator::encodeDigit(unsigned int unDigit) {
+    static const char* cDigits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    
+    return cDigits[unDigit % 62];
+  }
+  
+  void UniqueIDGenerator::reset() {
+    std::random_device rdDevice;
+    std::mt19937 mtGenerator(rdDevice());
+    std::uniform_int_distribution<unsigned int> uidDigits(0, 61);
+    
+    m_strSalt.resize(s_unSaltLength);
+    for(unsigned int unI = 0; unI < s_unSaltLength; unI++) {
+      m_strSalt[unI] = encodeDigit(uidDigits(mtGenerator));
+    }
+    
+    m_ullCounter = 0;
+  }
+  
+  std::string UniqueIDGenerator::uniqueID(std::string strPrefix, unsigned int unLength) {
+    unsigned long long ullCount = m_ullCounter++;
+    
+    // Counter digits, least significant first
+    char cCounter[24];
+    unsigned int unDigits = 0;
+    
+    do {
+      cCounter[unDigits++] = encodeDigit(ullCount % 62);
+      ullCount /= 62;
+    } while(ullCount > 0);
+    
+    while(unDigits < s_unMinCounterDigits) {
+      cCounter[unDigits++] = encodeDigit(0);
+    }
+    
+    unsigned int unSaltLength = (unLength > unDigits ? unLength - unDigits : 0);
+    if(unSaltLength > s_unSaltLength) {
+      unSaltLength = s_unSaltLength;
+    }
+    
+    std::string strID;
+    strID.reserve(strPrefix.size() + unSaltLength + unDigits);
+    strID += strPrefix;
+    strID.append(m_strSalt, 0, unSaltLength);
+    
+    for(unsigned int unI = unDigits; unI > 0; unI--) {
+      strID += cCounter[unI - 1];
+    }
+    
+    return strID;
+  }
+}
@@ -41,8 +41,8 @@
 
 
 namespace semrec {
-  bool UtilityBase::m_bRedirectOutput = false;
   bool UtilityBase::m_bQuiet = false;
+  MessageLevel UtilityBase::m_mlMinimumLevel = ML_INFO;
   
   
   UtilityBase::UtilityBase() {
@@ -71,29 +71,35 @@ namespace semrec {
   }
   
   void UtilityBase::coloredText(std::string strText, std::string strColorValue, bool bBold, bool bImportant) {
-    if((!m_bOnlyDisplayImportant || (m_bOnlyDisplayImportant && bImportant)) && !m_bQuiet) {
-      StatusMessage msgStatus = queueMessage(strColorValue, bBold, this->messagePrefixLabel(), strText);
-      
-      if(!m_bRedirectOutput) {
-	this->outputColoredStatusMessage(msgStatus);
-      }
+    if((!m_bOnlyDisplayImportant || bImportant) && !m_bQuiet) {
+      // Console output and delivery to consumers is done by the
+      // message sink.
+      queueMessage(strColorValue, bBold, this->messagePrefixLabel(), strText);
     }
   }
   
   void UtilityBase::info(std::string strMessage, bool bImportant) {
-    this->coloredText(strMessage, "37", false, bImportant);
+    if(this->messageEnabled(ML_INFO, bImportant)) {
+      this->coloredText(strMessage, "37", false, bImportant);
+    }
   }
   
   void UtilityBase::success(std::string strMessage, bool bImportant) {
-    this->coloredText(strMessage, "32", false, bImportant);
+    if(this->messageEnabled(ML_SUCCESS, bImportant)) {
+      this->coloredText(strMessage, "32", false, bImportant);
+    }
   }
   
   void UtilityBase::warn(std::string strMessage, bool bImportant) {
-    this->coloredText(strMessage, "33", true, bImportant);
+    if(this->messageEnabled(ML_WARN, bImportant)) {
+      this->coloredText(strMessage, "33", true, bImportant);
+    }
   }
   
   void UtilityBase::fail(std::string strMessage, bool bImportant) {
-    this->coloredText(strMessage, "31", true, bImportant);
+    if(this->messageEnabled(ML_FAIL, bImportant)) {
+      this->coloredText(strMessage, "31", true, bImportant);
+    }
   }
   
   bool UtilityBase::fileExists(std::string strFileName) {
@@ -125,7 +131,7 @@ namespace semrec {
   }
   
   void UtilityBase::setRedirectOutput(bool bRedirect) {
-    m_bRedirectOutput = bRedirect;
+    messageSink().setConsoleOutput(!bRedirect);
   }
   
   void UtilityBase::replaceStringInPlace(std::string& subject, const std::string& search, const std::string& replace) {
@@ -177,31 +183,42 @@ namespace semrec {
     return this->getTimeStampStr(this->getSystemTimeStampPrecise(), 3);
   }
   
-  std::string UtilityBase::str(float fValue) {
-    std::stringstream sts;
-    sts.imbue(std::locale(sts.getloc(), new std::numpunct<char>()));
+  /*! \brief Per-thread number formatting stream
     
+    Imbuing a fresh locale into a new stringstream for every number
+    was the dominant cost of building log messages. The stream is set
+    up once per thread and only has its contents reset per call. */
+  static std::ostringstream& numberFormatStream() {
+    thread_local std::ostringstream stsNumbers;
+    thread_local bool bImbued = false;
+    
+    if(!bImbued) {
+      stsNumbers.imbue(std::locale::classic());
+      bImbued = true;
+    }
+    
+    stsNumbers.str("");
+    stsNumbers.clear();
+    
+    return stsNumbers;
+  }
+  
+  std::string UtilityBase::str(float fValue) {
+    std::ostringstream& sts = numberFormatStream();
     sts << fValue;
     
     return sts.str();
   }
   
   std::string UtilityBase::str(double dValue) {
-    std::stringstream sts;
-    sts.imbue(std::locale(sts.getloc(), new std::numpunct<char>()));
-    
+    std::ostringstream& sts = numberFormatStream();
     sts << dValue;
     
     return sts.str();
   }
   
   std::string UtilityBase::str(int nValue) {
-    std::stringstream sts;
-    sts.imbue(std::locale(sts.getloc(), new std::numpunct<char>()));
-    
-    sts << nValue;
-    
-    return sts.str();
+    return std::to_string(nValue);
   }
   
   void UtilityBase::setOnlyDisplayImportant(bool bOnly) {
@@ -212,6 +229,30 @@ namespace semrec {
     return m_bOnlyDisplayImportant;
   }
   
+  void UtilityBase::setMinimumMessageLevel(MessageLevel mlLevel) {
+    m_mlMinimumLevel = mlLevel;
+  }
+  
+  MessageLevel UtilityBase::minimumMessageLevel() {
+    return m_mlMinimumLevel;
+  }
+  
+  bool UtilityBase::messageLevelFromString(std::string strLevel, MessageLevel& mlLevel) {
+    if(strLevel == "info") {
+      mlLevel = ML_INFO;
+    } else if(strLevel == "success") {
+      mlLevel = ML_SUCCESS;
+    } else if(strLevel == "warn") {
+      mlLevel = ML_WARN;
+    } else if(strLevel == "fail") {
+      mlLevel = ML_FAIL;
+    } else {
+      return false;
+    }
+    
+    return true;
+  }
+  
   void UtilityBase::setTimeFloatingPointPrecision(int nPrecision) {
     m_nTimeFloatingPointPrecision = nPrecision;
   }
@@ -0,0 +1,227 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <semrec/WorkerPool.h>
+
+
+namespace semrec {
+  // The pool and worker index the calling thread belongs to, if any.
+  static thread_local WorkerPool* g_wpCurrentPool = NULL;
+  static thread_local unsigned int g_unCurrentWorker = 0;
+  
+  
+  WorkerPool::WorkerPool(unsigned int unThreads) {
+    m_bRun = true;
+    m_unPendingTasks = 0;
+    m_unNextWorker = 0;
+    
+    // At least one worker, so enqueued tasks always get executed.
+    if(unThreads == 0) {
+      unThreads = 1;
+    }
+    
+    for(unsigned int unI = 0; unI < unThreads; unI++) {
+      m_vecWorkers.push_back(new Worker());
+    }
+    
+    // Only start the threads once all queues exist, as they steal
+    // from each other.
+    for(unsigned int unI = 0; unI < unThreads; unI++) {
+      m_vecWorkers[unI]->thrdWorker = new std::thread(&WorkerPool::work, this, unI);
+    }
+  }
+  
+  WorkerPool::~WorkerPool() {
+    this->shutdown();
+  }
+  
+  bool WorkerPool::takeTask(unsigned int unWorker, std::function<void()>& fncTask) {
+    unsigned int unWorkers = m_vecWorkers.size();
+    
+    for(unsigned int unI = 0; unI < unWorkers; unI++) {
+      Worker* wkVictim = m_vecWorkers[(unWorker + unI) % unWorkers];
+      bool bTaken = false;
+      
+      wkVictim->mtxTasks.lock();
+      if(!wkVictim->dqTasks.empty()) {
+	if(unI == 0) {
+	  // Own queue: newest first
+	  fncTask = std::move(wkVictim->dqTasks.back());
+	  wkVictim->dqTasks.pop_back();
+	} else {
+	  // Someone else's queue: steal the oldest
+	  fncTask = std::move(wkVictim->dqTasks.front());
+	  wkVictim->dqTasks.pop_front();
+	}
+	
+	// Decrementing under the queue lock keeps the counter in step
+	// with the queues, just like enqueue() increments it.
+	m_unPendingTasks--;
+	bTaken = true;
+      }
+      wkVictim->mtxTasks.unlock();
+      
+      if(bTaken) {
+	return true;
+      }
+    }
+    
+    return false;
+  }
+  
+  void WorkerPool::work(unsigned int unWorker) {
+    g_wpCurrentPool = this;
+    g_unCurrentWorker = unWorker;
+    
+    while(true) {
+      std::function<void()> fncTask;
+      
+      if(this->takeTask(unWorker, fncTask)) {
+	fncTask();
+      } else {
+	std::unique_lock<std::mutex> lckIdle(m_mtxIdle);
+	
+	while(m_bRun && m_unPendingTasks == 0) {
+	  m_cvIdle.wait(lckIdle);
+	}
+	
+	if(!m_bRun && m_unPendingTasks == 0) {
+	  // Not running anymore, and nothing left to do.
+	  break;
+	}
+      }
+    }
+    
+    g_wpCurrentPool = NULL;
+  }
+  
+  void WorkerPool::enqueue(std::function<void()> fncTask) {
+    unsigned int unWorker;
+    
+    if(g_wpCurrentPool == this) {
+      unWorker = g_unCurrentWorker;
+    } else {
+      unWorker = m_unNextWorker++ % m_vecWorkers.size();
+    }
+    
+    Worker* wkTarget = m_vecWorkers[unWorker];
+    wkTarget->mtxTasks.lock();
+    wkTarget->dqTasks.push_back(std::move(fncTask));
+    m_unPendingTasks++;
+    wkTarget->mtxTasks.unlock();
+    
+    // Taking the idle lock makes sure no worker is between checking
+    // for pending tasks and going to sleep.
+    m_mtxIdle.lock();
+    m_mtxIdle.unlock();
+    m_cvIdle.notify_one();
+  }
+  
+  void WorkerPool::shutdown() {
+    m_mtxIdle.lock();
+    m_bRun = false;
+    m_mtxIdle.unlock();
+    
+    m_cvIdle.notify_all();
+    
+    for(Worker* wkWorker : m_vecWorkers) {
+      wkWorker->thrdWorker->join();
+      delete wkWorker->thrdWorker;
+      delete wkWorker;
+    }
+    
+    m_vecWorkers.clear();
+  }
+  
+  unsigned int WorkerPool::threadCount() {
+    return m_vecWorkers.size();
+  }
+  
+  
+  WorkerStrand::WorkerStrand(WorkerPool* wpPool) {
+    m_wpPool = wpPool;
+    m_bDraining = false;
+  }
+  
+  WorkerStrand::~WorkerStrand() {
+    this->wait();
+  }
+  
+  void WorkerStrand::enqueue(std::function<void()> fncTask) {
+    m_mtxTasks.lock();
+    m_dqTasks.push_back(std::move(fncTask));
+    
+    bool bSchedule = !m_bDraining;
+    m_bDraining = true;
+    m_mtxTasks.unlock();
+    
+    if(bSchedule) {
+      m_wpPool->enqueue(std::bind(&WorkerStrand::drain, this));
+    }
+  }
+  
+  void WorkerStrand::drain() {
+    while(true) {
+      m_mtxTasks.lock();
+      
+      if(m_dqTasks.empty()) {
+	m_bDraining = false;
+	
+	// Notify before unlocking: once a waiter sees the flag, this
+	// strand may be destroyed.
+	m_cvDrained.notify_all();
+	m_mtxTasks.unlock();
+	
+	break;
+      }
+      
+      std::function<void()> fncTask = std::move(m_dqTasks.front());
+      m_dqTasks.pop_front();
+      m_mtxTasks.unlock();
+      
+      fncTask();
+    }
+  }
+  
+  void WorkerStrand::wait() {
+    std::unique_lock<std::mutex> lckTasks(m_mtxTasks);
+    
+    while(m_bDraining) {
+      m_cvDrained.wait(lckTasks);
+    }
+  }
+}
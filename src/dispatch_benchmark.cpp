@@ -0,0 +1,160 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Measures how event delivery scales when subscribers are handed
+// their events on WorkerStrands of a shared WorkerPool (as with
+// `parallel-dispatch') instead of being called one after the other
+// on the dispatching thread.
+//
+// Usage: semrec_dispatch_benchmark [subscribers] [events] [work]
+//
+// Every subscriber spends `work' rounds of hashing on each event,
+// standing in for what exporters and loggers do in consumeEvent().
+// Parallel deliveries also pay for copying the event payload, like
+// PluginInstance::queueEvent() does with the designator.
+
+
+// System
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <functional>
+
+// Private
+#include <semrec/WorkerPool.h>
+
+
+typedef struct {
+  unsigned long unState;
+} Subscriber;
+
+
+void consume(Subscriber* sbSubscriber, std::string strPayload, unsigned int unWork) {
+  unsigned long unHash = sbSubscriber->unState;
+  
+  for(unsigned int unRound = 0; unRound < unWork; unRound++) {
+    for(char cChar : strPayload) {
+      unHash = (unHash ^ (unsigned char)cChar) * 1099511628211ul;
+    }
+  }
+  
+  sbSubscriber->unState = unHash;
+}
+
+double runSerial(std::vector<Subscriber>& vecSubscribers, std::string strPayload, unsigned int unEvents, unsigned int unWork) {
+  std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+  
+  for(unsigned int unEvent = 0; unEvent < unEvents; unEvent++) {
+    for(Subscriber& sbSubscriber : vecSubscribers) {
+      consume(&sbSubscriber, strPayload, unWork);
+    }
+  }
+  
+  std::chrono::duration<double> durElapsed = std::chrono::steady_clock::now() - tpStart;
+  
+  return unEvents / durElapsed.count();
+}
+
+double runParallel(std::vector<Subscriber>& vecSubscribers, std::string strPayload, unsigned int unEvents, unsigned int unWork, unsigned int unThreads) {
+  semrec::WorkerPool wpPool(unThreads);
+  std::vector<semrec::WorkerStrand*> vecStrands;
+  
+  for(unsigned int unI = 0; unI < vecSubscribers.size(); unI++) {
+    vecStrands.push_back(new semrec::WorkerStrand(&wpPool));
+  }
+  
+  std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+  
+  for(unsigned int unEvent = 0; unEvent < unEvents; unEvent++) {
+    for(unsigned int unI = 0; unI < vecSubscribers.size(); unI++) {
+      vecStrands[unI]->enqueue(std::bind(consume, &vecSubscribers[unI], strPayload, unWork));
+    }
+  }
+  
+  for(semrec::WorkerStrand* wsStrand : vecStrands) {
+    wsStrand->wait();
+  }
+  
+  std::chrono::duration<double> durElapsed = std::chrono::steady_clock::now() - tpStart;
+  
+  for(semrec::WorkerStrand* wsStrand : vecStrands) {
+    delete wsStrand;
+  }
+  
+  wpPool.shutdown();
+  
+  return unEvents / durElapsed.count();
+}
+
+int main(int argc, char** argv) {
+  unsigned int unSubscribers = (argc > 1 ? atoi(argv[1]) : 8);
+  unsigned int unEvents = (argc > 2 ? atoi(argv[2]) : 20000);
+  unsigned int unWork = (argc > 3 ? atoi(argv[3]) : 16);
+  unsigned int unCores = std::thread::hardware_concurrency();
+  
+  if(unCores == 0) {
+    unCores = 1;
+  }
+  
+  std::string strPayload(256, 'x');
+  std::vector<Subscriber> vecSubscribers(unSubscribers, {14695981039346656037ul});
+  
+  std::cout << unSubscribers << " subscribers, " << unEvents << " events, " << unWork << " rounds of work per delivery" << std::endl;
+  
+  double dSerial = runSerial(vecSubscribers, strPayload, unEvents, unWork);
+  std::cout << "serial:              " << (unsigned long)dSerial << " events/s" << std::endl;
+  
+  for(unsigned int unThreads = 1; unThreads <= unCores; unThreads *= 2) {
+    double dParallel = runParallel(vecSubscribers, strPayload, unEvents, unWork, unThreads);
+    
+    std::cout << "parallel, " << unThreads << " thread(s): " << (unsigned long)dParallel << " events/s ("
+	      << dParallel / dSerial << "x)" << std::endl;
+  }
+  
+  // Keep the work from being optimized away
+  unsigned long unChecksum = 0;
+  for(Subscriber& sbSubscriber : vecSubscribers) {
+    unChecksum += sbSubscriber.unState;
+  }
+  
+  std::cout << "checksum: " << unChecksum << std::endl;
+  
+  return EXIT_SUCCESS;
+}
@@ -164,9 +164,14 @@ int main(int argc, char** argv) {
 	std::cout << "Signify: semrec init complete (version " + g_srRecorder->version() << ")" << std::endl;
       }
       
+      // Sleep between cycles until a plugin deploys data. Signal
+      // handlers can't safely notify the wakeup condition, so
+      // shutdown and terminal resizes are picked up by the fallback
+      // tick at the latest.
+      float fMaxCycleLatency = semrec::configSnapshot()->fMaxCycleLatency;
+      
       while(g_srRecorder->cycle()) {
-	// Idle here at will.
-	usleep(10);
+	semrec::waitForCoreWakeup(fMaxCycleLatency);
       }
     } else {
       g_srRecorder->fail("Initialization of the recorder system failed. Being a quitter.");
@@ -52,7 +52,7 @@ namespace semrec {
       this->renewUniqueIDs();
       int nMaxDetailLevel = this->configuration()->floatValue("max-detail-level");
       
-      std::string strGraphID = this->generateRandomIdentifier("plangraph_");
+      std::string strGraphID = this->generateUniqueID("plangraph_");
       std::string strToplevelID = this->generateUniqueID("node_");
       
       std::string strDot = "digraph " + strGraphID + " {\n";
@@ -70,16 +70,25 @@ namespace semrec {
     return false;
   }
   
-  int CExporterDot::countNodes(std::list<Node*> lstNodes) {
-    int nCount = 0;
-    
-    for(Node* ndNode : lstNodes) {
-      nCount++;
+  int CExporterDot::countNodes(const std::vector<Node*>& vecNodes) {
+    class CountVisitor : public NodeVisitor {
+    public:
+      int m_nCount;
       
-      nCount += this->countNodes(ndNode->subnodes());
+      bool enterNode(Node* ndNode) {
+	m_nCount++;
+	
+	return true;
+      }
+    } cvVisitor;
+    
+    cvVisitor.m_nCount = 0;
+    
+    for(Node* ndNode : vecNodes) {
+      ndNode->accept(cvVisitor);
     }
     
-    return nCount;
+    return cvVisitor.m_nCount;
   }
   
   bool CExporterDot::runSequentialExporter() {
@@ -89,11 +98,11 @@ namespace semrec {
       this->renewUniqueIDs();
       int nMaxDetailLevel = this->configuration()->floatValue("max-detail-level");
       
-      std::string strGraphID = this->generateRandomIdentifier("plangraph_");
+      std::string strGraphID = this->generateUniqueID("plangraph_");
       std::string strToplevelID = this->generateUniqueID("node_");
       bReturnvalue = true;
       
-      int nNodeCount = this->countNodes(m_lstNodes);
+      int nNodeCount = this->countNodes(m_vecNodes);
       
       for(int nI = 1; nI < nNodeCount + 1; nI++) {
 	std::string strDot = "digraph " + strGraphID + " {\n";
@@ -202,17 +211,17 @@ namespace semrec {
     return strDot;
   }
 
-  std::string CExporterDot::generateDotStringForNodes(std::list<Node*> lstNodes, std::string strParentID, int& nIndex) {
+  std::string CExporterDot::generateDotStringForNodes(const std::vector<Node*>& vecNodes, std::string strParentID, int& nIndex) {
     std::string strDot = "";
     
-    for(Node* ndCurrent : lstNodes) {
+    for(Node* ndCurrent : vecNodes) {
       if(this->nodeDisplayable(ndCurrent)) {
 	std::string strNodeID = ndCurrent->uniqueID();
 	
 	std::string strFillColor;
 	std::string strEdgeColor;
 	
-	if(ndCurrent->metaInformation()->floatValue("success") == 1) {
+	if(ndCurrent->success()) {
 	  strFillColor = "#ddffdd";
 	  strEdgeColor = "green";
 	} else {
@@ -221,8 +230,8 @@ namespace semrec {
 	}
 	
 	std::string strParameters = this->generateDotStringForDescription(ndCurrent->description(),
-									  ndCurrent->metaInformation()->floatValue("time-start"),
-									  ndCurrent->metaInformation()->floatValue("time-end"));
+									  (ndCurrent->hasTimeStart() ? ndCurrent->timeStart() : -1),
+									  (ndCurrent->hasTimeEnd() ? ndCurrent->timeEnd() : -1));
 	std::string strLabel = "{" + this->dotEscapeString(ndCurrent->title()) + strParameters + "}";
 	bool bVisible = nIndex > 0 || nIndex == -1;
 	
@@ -231,7 +240,7 @@ namespace semrec {
 	  
 	  if(nIndex == 0) {
 	    // This stretch just ended
-	    m_lstTimeTableTimePoints.push_back(ndCurrent->metaInformation()->stringValue("time-start"));
+	    m_lstTimeTableTimePoints.push_back(ndCurrent->timeStartString());
 	  }
 	}
 	
@@ -264,15 +273,13 @@ namespace semrec {
   std::string CExporterDot::generateDotImagesStringForNode(Node *ndImages, bool bVisible) {
     std::string strDot = "";
     
-    KeyValuePair *ckvpImages = ndImages->metaInformation()->childForKey("images");
+    const std::vector<NodeImage>& vecImages = ndImages->images();
     
-    if(ckvpImages) {
-      std::list<KeyValuePair*> lstChildren = ckvpImages->children();
-      
+    if(vecImages.size() > 0) {
       unsigned int unIndex = 0;
-      for(KeyValuePair* ckvpChild : lstChildren) {
-	std::string strOrigin = ckvpChild->stringValue("origin");
-	std::string strFilename = ckvpChild->stringValue("filename");
+      for(const NodeImage& niImage : vecImages) {
+	std::string strOrigin = niImage.strOrigin;
+	std::string strFilename = niImage.strFilename;
 	
 	std::stringstream sts;
 	sts << ndImages->uniqueID() << "_image_" << unIndex;
@@ -289,13 +296,11 @@ namespace semrec {
   std::string CExporterDot::generateDotObjectsStringForNode(Node *ndObjects, bool bVisible) {
     std::string strDot = "";
     
-    KeyValuePair *ckvpObjects = ndObjects->metaInformation()->childForKey("objects");
+    const std::vector<KeyValuePair*>& vecObjects = ndObjects->objects();
     
-    if(ckvpObjects) {
-      std::list<KeyValuePair*> lstChildren = ckvpObjects->children();
-      
+    if(vecObjects.size() > 0) {
       unsigned int unIndex = 0;
-      for(KeyValuePair* ckvpChild : lstChildren) {
+      for(KeyValuePair* ckvpChild : vecObjects) {
 	std::string strDefClass = ckvpChild->stringValue("_class");
 	std::string strDefProperty = ckvpChild->stringValue("_property");
 	
@@ -53,6 +53,7 @@ namespace semrec {
       Result resInit = defaultResult();
       
       this->setSubscribedToEvent("export-planlog", true);
+      this->setParallelDispatch(true);
       
       Designator* cdConfig = this->getIndividualConfig();
       m_bCreateSequentialFiles = cdConfig->floatValue("create-sequential-files");
@@ -71,7 +72,7 @@ namespace semrec {
       return resCycle;
     }
     
-    void PLUGIN_CLASS::consumeEvent(Event evEvent) {
+    void PLUGIN_CLASS::consumeEvent(const Event& evEvent) {
       if(evEvent.cdDesignator) {
 	std::string strFormat = evEvent.cdDesignator->stringValue("format");
 	transform(strFormat.begin(), strFormat.end(), strFormat.begin(), ::tolower);
@@ -79,19 +80,23 @@ namespace semrec {
 	if(strFormat == "dot") {
 	  ServiceEvent seGetPlanTree = defaultServiceEvent("symbolic-plan-tree");
 	  seGetPlanTree.cdDesignator = new Designator(evEvent.cdDesignator);
-	  this->deployServiceEvent(seGetPlanTree);
+	  
+	  if(this->parallelDispatch() && configSnapshot()->bParallelDispatch) {
+	    seGetPlanTree.cdDesignator->setValue(std::string("snapshot"), 1);
+	  }
+	  
+	  this->requestService(seGetPlanTree, std::bind(&PLUGIN_CLASS::exportPlanTree, this, std::placeholders::_1));
 	}
       }
     }
     
-    Event PLUGIN_CLASS::consumeServiceEvent(ServiceEvent seServiceEvent) {
-      Event evResult = defaultEvent();
-      
+    void PLUGIN_CLASS::exportPlanTree(const ServiceEvent& seServiceEvent) {
       if(seServiceEvent.siServiceIdentifier == SI_RESPONSE) {
 	if(seServiceEvent.strServiceName == "symbolic-plan-tree") {
 	  if(seServiceEvent.cdDesignator) {
-	    if(seServiceEvent.lstResultEvents.size() > 0) {
-	      Event evCar = seServiceEvent.lstResultEvents.front();
+	    if(seServiceEvent.lstResultEvents.size() > 0 && seServiceEvent.lstResultEvents.front().ptdPlanTree) {
+	      const Event& evCar = seServiceEvent.lstResultEvents.front();
+	      const PlanTreeData& ptdPlanTree = *evCar.ptdPlanTree;
 	      
 	      std::string strFormat = seServiceEvent.cdDesignator->stringValue("format");
 	      transform(strFormat.begin(), strFormat.end(), strFormat.begin(), ::tolower);
@@ -110,12 +115,9 @@ namespace semrec {
 		  expDot->addNode(ndNode);
 		}
 		
-		expDot->setDesignatorIDs(evCar.lstDesignatorIDs);
-		expDot->setDesignatorEquations(evCar.lstEquations);
-		expDot->setDesignatorEquationTimes(evCar.lstEquationTimes);
+		expDot->setDesignatorRegistry(ptdPlanTree.drDesignators);
 		
-		ConfigSettings cfgsetCurrent = configSettings();
-		expDot->setOutputFilename(cfgsetCurrent.strExperimentDirectory + seServiceEvent.cdDesignator->stringValue("filename"));
+		expDot->setOutputFilename(configSnapshot()->strExperimentDirectory + seServiceEvent.cdDesignator->stringValue("filename"));
 		
 		if(expDot->runExporter(NULL)) {
 		  this->info("Successfully exported DOT file '" + expDot->outputFilename() + "'", true);
@@ -137,8 +139,6 @@ namespace semrec {
 	  }
 	}
       }
-      
-      return evResult;
     }
   }
   
@@ -45,10 +45,24 @@ namespace semrec {
     m_strPropertyNamespace = "";
     m_strDefaultAnnotation = "";
     
+    // NOTE(winkler): This used to be `random'. Changed this due to
+    // non-necessity of such a long namespace.
+    // this->generateRandomIdentifier("namespace_", 8);
+    m_strNamespaceID = "log";
+    m_strNamespace = "http://knowrob.org/kb/cram_log.owl";
+    
+    m_nThrowAndCatchFailureCounter = 0;
+    m_bSpooling = false;
+    m_bIgnoreSpool = false;
+    m_bfwSpool = NULL;
+    m_tsSpooled = {"", "", 0.0, 0.0, false};
+    m_nSpooledThrowAndCatchFailureCounter = 0;
+    
     this->setMessagePrefixLabel("owl-exporter-aux");
   }
   
   CExporterOwl::~CExporterOwl() {
+    this->stopSpool();
   }
   
   void CExporterOwl::setMetaData(std::map<std::string, MappedMetaData> mapMetaData) {
@@ -56,7 +70,7 @@ namespace semrec {
     
     // NOTE(winkler): This is a hack and needs to be resolved later.
     if(mapMetaData.find("robot") != mapMetaData.end()) {
-      OwlIndividual::addStaticProperty("robot", mapMetaData["robot"].strValue);
+      m_ospStatic.mapProperties["robot"] = mapMetaData["robot"].strValue;
     }
   }
   
@@ -194,21 +208,19 @@ namespace semrec {
     m_lstEntities.push_back(std::make_pair(strNickname, strNamespace));
   }
 
-  std::string CExporterOwl::generateDocTypeBlock() {
-    std::string strDot = "<!DOCTYPE rdf:RDF [\n";
+  void CExporterOwl::generateDocTypeBlock(OutputSink& osOwl) {
+    osOwl << "<!DOCTYPE rdf:RDF [\n";
     
     for(std::pair<std::string, std::string> prEntity : m_lstEntities) {
-      strDot += "    <!ENTITY " + prEntity.first + " \"" + prEntity.second + "\">\n";
+      osOwl << "    <!ENTITY " + prEntity.first + " \"" + prEntity.second + "\">\n";
     }
   
-    strDot += "]>\n\n";
-    
-    return strDot;
+    osOwl << "]>\n\n";
   }
 
-  std::string CExporterOwl::generateXMLNSBlock(std::string strNamespace) {
-    std::string strDot = "<rdf:RDF xmlns=\"" + strNamespace + "#\"\n";
-    strDot += "     xml:base=\"" + strNamespace + "\"\n";
+  void CExporterOwl::generateXMLNSBlock(std::string strNamespace, OutputSink& osOwl) {
+    osOwl << "<rdf:RDF xmlns=\"" + strNamespace + "#\"\n";
+    osOwl << "     xml:base=\"" + strNamespace + "\"\n";
     
     for(std::list< std::pair<std::string, std::string> >::iterator itPair = m_lstEntities.begin();
 	itPair != m_lstEntities.end();
@@ -216,47 +228,40 @@ namespace semrec {
       std::pair<std::string, std::string> prEntity = *itPair;
       
       if(itPair != m_lstEntities.begin()) {
-	strDot += "\n";
+	osOwl << "\n";
       }
 
-      strDot += "     xmlns:" + prEntity.first + "=\"" + prEntity.second + "\"";
+      osOwl << "     xmlns:" + prEntity.first + "=\"" + prEntity.second + "\"";
     }
 
-    strDot += ">\n\n";
-    return strDot;
+    osOwl << ">\n\n";
   }
   
-  std::string CExporterOwl::generateOwlImports(std::string strNamespace) {
-    std::string strDot = "";
+  void CExporterOwl::generateOwlImports(std::string strNamespace, OutputSink& osOwl) {
     std::string strImportNamespace = "package://knowrob_common/owl/knowrob.owl";
     
-    strDot += "    <owl:Ontology rdf:about=\"" + strNamespace + "\">\n";
-    strDot += "        <owl:imports rdf:resource=\"" + strImportNamespace + "\"/>\n";
-    strDot += "    </owl:Ontology>\n\n";
-    
-    return strDot;
+    osOwl << "    <owl:Ontology rdf:about=\"" + strNamespace + "\">\n";
+    osOwl << "        <owl:imports rdf:resource=\"" + strImportNamespace + "\"/>\n";
+    osOwl << "    </owl:Ontology>\n\n";
   }
 
-  std::string CExporterOwl::generatePropertyDefinitions() {
-    std::string strDot = "    <!-- Property Definitions -->\n\n";
+  void CExporterOwl::generatePropertyDefinitions(const OwlVocabulary& ovIssued, OutputSink& osOwl) {
+    osOwl << "    <!-- Property Definitions -->\n\n";
     
-    std::list<std::string> lstProperties = OwlIndividual::issuedProperties();
-    for(std::string strProperty : lstProperties) {
-      strDot += "    <owl:ObjectProperty rdf:about=\"" + strProperty + "\"/>\n\n";
+    for(const std::string& strProperty : ovIssued.issuedProperties()) {
+      osOwl << "    <owl:ObjectProperty rdf:about=\"" + strProperty + "\"/>\n\n";
     }
-    
-    return strDot;
   }
   
-  std::list<std::string> CExporterOwl::gatherClassesForNodes(std::list<Node*> lstNodes) {
+  std::list<std::string> CExporterOwl::gatherClassesForNodes(const std::vector<Node*>& vecNodes) {
     std::list<std::string> lstClasses;
     
-    for(Node* ndCurrent : lstNodes) {
+    for(Node* ndCurrent : vecNodes) {
       if(ndCurrent) {
 	std::list<std::string> lstClassesSubnodes = this->gatherClassesForNodes(ndCurrent->subnodes());
 	
-	if(ndCurrent->metaInformation()->stringValue("class") != "") {
-	  lstClassesSubnodes.push_back(ndCurrent->metaInformation()->stringValue("classnamespace") + ndCurrent->metaInformation()->stringValue("class"));
+	if(ndCurrent->className() != "") {
+	  lstClassesSubnodes.push_back(ndCurrent->classNamespace() + ndCurrent->className());
 	} else {
 	  lstClassesSubnodes.push_back(this->owlClassForNode(ndCurrent));
 	}
@@ -283,80 +288,72 @@ namespace semrec {
     return lstClasses;
   }
   
-  std::list<std::string> CExporterOwl::gatherTimepointsForNodes(std::list<Node*> lstNodes, std::list<Node*> lstTrace) {
-    std::list<std::string> lstTimepoints;
-    
-    for(Node* ndCurrent : lstNodes) {
-      if(ndCurrent) {
-	if(std::find(lstTrace.begin(), lstTrace.end(), ndCurrent) == lstTrace.end()) {
-	  // Gather node timepoints
-	  std::list<Node*> lstSubTrace = lstTrace;
-	  lstSubTrace.push_back(ndCurrent);
-	  
-	  std::list<std::string> lstTimepointsSubnodes = this->gatherTimepointsForNodes(ndCurrent->subnodes(), lstSubTrace);
-	  lstTimepointsSubnodes.push_back(ndCurrent->metaInformation()->stringValue("time-start"));
-	  lstTimepointsSubnodes.push_back(ndCurrent->metaInformation()->stringValue("time-end"));
-	  lstTimepointsSubnodes.push_back(ndCurrent->metaInformation()->stringValue("time-start-system"));
-	  
-	  // Gather failure timepoints
-	  KeyValuePair* ckvpFailures = ndCurrent->metaInformation()->childForKey("failures");
-	  
-	  if(ckvpFailures) {
-	    std::list<KeyValuePair*> lstFailures = ckvpFailures->children();
-	    
-	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpFailure : lstFailures) {
-	      lstTimepointsSubnodes.push_back(ckvpFailure->stringValue("time-fail"));
-	    }
-	  }
-	  
-	  // Gather image timepoints
-	  KeyValuePair* ckvpImages = ndCurrent->metaInformation()->childForKey("images");
-	  
-	  if(ckvpImages) {
-	    std::list<KeyValuePair*> lstImages = ckvpImages->children();
-	  
-	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpImage : lstImages) {
-	      lstTimepointsSubnodes.push_back(ckvpImage->stringValue("time-capture"));
-	    }
-	  }
+  void CExporterOwl::gatherTimepointsForNodes(const std::vector<Node*>& vecNodes, std::vector<std::string>& vecTimepoints, bool bRecursive) {
+    class TimepointsVisitor : public NodeVisitor {
+    public:
+      CExporterOwl* m_expOwl;
+      std::vector<std::string>* m_vecTimepoints;
+      bool m_bRecursive;
+      
+      bool enterNode(Node* ndNode) {
+	return m_bRecursive && !m_expOwl->nodeSpooled(ndNode);
+      }
+      
+      void leaveNode(Node* ndNode) {
+	if(m_expOwl->nodeSpooled(ndNode)) {
+	  return;
+	}
 	
-	  // Gather designator equation timepoints
-	  for(std::pair<std::string, std::string> prPair : m_lstDesignatorEquationTimes) {
-	    lstTimepointsSubnodes.push_back(prPair.second);
-	  }
+	// Gather node timepoints
+	m_vecTimepoints->push_back(ndNode->timeStartString());
+	m_vecTimepoints->push_back(ndNode->timeEndString());
+	m_vecTimepoints->push_back(ndNode->timeStartSystemString());
 	
-	  // Gather designator creation timepoints
-	  for(std::pair<std::string, KeyValuePair*> prDesig : m_mapDesignators) {
-	    if(prDesig.second) {
-	      if(prDesig.second->childForKey("description")) {
-		lstTimepointsSubnodes.push_back(prDesig.second->childForKey("description")->stringValue("_time_created"));
-	      }
-	    }
-	  }
-	  
-	  std::copy(lstTimepointsSubnodes.begin(), lstTimepointsSubnodes.end(),
-		    std::back_insert_iterator<std::list<std::string> >(lstTimepoints));
+	// Gather failure timepoints
+	for(const NodeFailure& nfFailure : ndNode->failures()) {
+	  m_vecTimepoints->push_back(nfFailure.strTimeFail);
 	}
+	
+	// Gather image timepoints
+	for(const NodeImage& niImage : ndNode->images()) {
+	  m_vecTimepoints->push_back(niImage.strTimeCapture);
+	}
+      }
+    } tvVisitor;
+    
+    tvVisitor.m_expOwl = this;
+    tvVisitor.m_vecTimepoints = &vecTimepoints;
+    tvVisitor.m_bRecursive = bRecursive;
+    
+    for(Node* ndCurrent : vecNodes) {
+      if(ndCurrent) {
+	ndCurrent->accept(tvVisitor);
       } else {
 	this->fail("Timepoints for invalid node requested!");
       }
     }
-    
-    return lstTimepoints;
   }
   
-  std::string CExporterOwl::generateClassDefinitions() {
-    std::string strDot = "    <!-- Class Definitions -->\n\n";
-    
-    std::list<std::string> lstClasses = OwlIndividual::issuedTypes();
+  void CExporterOwl::gatherDesignatorTimepoints(std::vector<std::string>& vecTimepoints) {
+    // Gather designator equation timepoints
+    for(const DesignatorEquation& deEquation : this->designatorRegistry().equations()) {
+      vecTimepoints.push_back(deEquation.strTime);
+    }
     
-    for(std::string strClass : lstClasses) {
-      strDot += "    <owl:Class rdf:about=\"" + strClass + "\"/>\n\n";
+    // Gather designator creation timepoints
+    for(const std::pair<const std::string, NodeDesignator>& prDesig : m_mapDesignators) {
+      if(prDesig.second.ckvpDescription) {
+	vecTimepoints.push_back(prDesig.second.ckvpDescription->stringValue("_time_created"));
+      }
     }
+  }
+  
+  void CExporterOwl::generateClassDefinitions(const OwlVocabulary& ovIssued, OutputSink& osOwl) {
+    osOwl << "    <!-- Class Definitions -->\n\n";
     
-    return strDot;
+    for(const std::string& strClass : ovIssued.issuedTypes()) {
+      osOwl << "    <owl:Class rdf:about=\"" + strClass + "\"/>\n\n";
+    }
   }
   
   std::string CExporterOwl::nodeIDPrefix(Node* ndInQuestion, std::string strProposition) {
@@ -374,23 +371,25 @@ namespace semrec {
     return strPrefix;
   }
   
-  std::string CExporterOwl::generateEventIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace) {
-    std::string strDot = "";
-    
-    m_mapDesignators.clear();
-    
+  void CExporterOwl::generateEventIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive) {
     Node* ndLastDisplayed = NULL;
-    for(std::list<Node*>::iterator itNode = lstNodes.begin();
-	itNode != lstNodes.end();
+    for(std::vector<Node*>::const_iterator itNode = vecNodes.begin();
+	itNode != vecNodes.end();
 	itNode++) {
       Node* ndCurrent = *itNode;
       
       if(ndCurrent) {
 	if(this->nodeDisplayable(ndCurrent)) {
+	  if(this->nodeSpooled(ndCurrent)) {
+	    // Written (with its whole subtree) while spooling.
+	    ndLastDisplayed = ndCurrent;
+	    continue;
+	  }
+	  
 	  std::string strOwlClass;
 	  
-	  if(ndCurrent->metaInformation()->stringValue("class") != "") {
-	    strOwlClass = ndCurrent->metaInformation()->stringValue("classnamespace") + ndCurrent->metaInformation()->stringValue("class");
+	  if(ndCurrent->className() != "") {
+	    strOwlClass = ndCurrent->classNamespace() + ndCurrent->className();
 	  } else {
 	    strOwlClass = this->owlClassForNode(ndCurrent);
 	  }
@@ -399,19 +398,21 @@ namespace semrec {
 	  // are always further up in the log. If this is not
 	  // intended, move it below the generation code for the
 	  // current node.
-	  strDot += this->generateEventIndividualsForNodes(ndCurrent->subnodes(), strNamespace);
+	  if(bRecursive) {
+	    this->generateEventIndividualsForNodes(ndCurrent->subnodes(), strNamespace, osOwl, ovIssued);
+	  }
 	  
 	  // NOTE: Here, the generation code the the current node
 	  // begins.
-	  OwlIndividual oiIndividual;
-	  oiIndividual.setID("&" + strNamespace + ";" + ndCurrent->uniqueID());
+	  OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
+	  oiIndividual.setID("&" + strNamespace + ";" + this->individualIDForNode(ndCurrent));
 	  oiIndividual.setType(strOwlClass);
 	  
 	  oiIndividual.addDataProperty("knowrob:taskContext", "&xsd;string", ndCurrent->title());
 	  oiIndividual.addDataProperty("knowrob:taskSuccess", "&xsd;boolean", (ndCurrent->success() ? std::string("true") : std::string("false")));
-	  oiIndividual.addResourceProperty("knowrob:startTime", "&" + strNamespace + ";timepoint_" + ndCurrent->metaInformation()->stringValue("time-start"));
-	  oiIndividual.addResourceProperty("knowrob:endTime", "&" + strNamespace + ";timepoint_" + ndCurrent->metaInformation()->stringValue("time-end"));
-	  oiIndividual.addResourceProperty("knowrob:startTimeSystem", "&" + strNamespace + ";timepoint_" + ndCurrent->metaInformation()->stringValue("time-start-system"));
+	  oiIndividual.addResourceProperty("knowrob:startTime", "&" + strNamespace + ";timepoint_" + ndCurrent->timeStartString());
+	  oiIndividual.addResourceProperty("knowrob:endTime", "&" + strNamespace + ";timepoint_" + ndCurrent->timeEndString());
+	  oiIndividual.addResourceProperty("knowrob:startTimeSystem", "&" + strNamespace + ";timepoint_" + ndCurrent->timeStartSystemString());
 	  
 	  if(ndCurrent->title() == "GOAL-ACHIEVE") {
 	    std::list<KeyValuePair*> lstDescription = ndCurrent->description();
@@ -477,22 +478,21 @@ namespace semrec {
           }
 
   
-	  std::list<Node*> lstSubnodes = ndCurrent->subnodes();
-	  for(Node* ndSubnode : lstSubnodes) {
+	  for(Node* ndSubnode : ndCurrent->subnodes()) {
 	    if(this->nodeDisplayable(ndSubnode)) {
-	      oiIndividual.addResourceProperty("knowrob:subAction", "&" + strNamespace + ";" + ndSubnode->uniqueID());
+	      oiIndividual.addResourceProperty("knowrob:subAction", "&" + strNamespace + ";" + this->individualIDForNode(ndSubnode));
 	    }
 	  }
 	  
 	  if(ndLastDisplayed) {
-	    oiIndividual.addResourceProperty("knowrob:previousAction", "&" + strNamespace + ";" + ndLastDisplayed->uniqueID());
+	    oiIndividual.addResourceProperty("knowrob:previousAction", "&" + strNamespace + ";" + this->individualIDForNode(ndLastDisplayed));
 	  }
 	  
-	  std::list<Node*>::iterator itPostEvent = itNode;
+	  std::vector<Node*>::const_iterator itPostEvent = itNode;
 	  itPostEvent++;
-	  while(itPostEvent != lstNodes.end()) {
+	  while(itPostEvent != vecNodes.end()) {
 	    if(this->nodeDisplayable(*itPostEvent)) {
-	      oiIndividual.addResourceProperty("knowrob:nextAction", "&" + strNamespace + ";" + (*itPostEvent)->uniqueID());
+	      oiIndividual.addResourceProperty("knowrob:nextAction", "&" + strNamespace + ";" + this->individualIDForNode(*itPostEvent));
 	      break;
 	    }
 	    
@@ -500,13 +500,11 @@ namespace semrec {
 	  }
 	  
 	  // Object references here.
-	  KeyValuePair* ckvpObjects = ndCurrent->metaInformation()->childForKey("objects");
+	  const std::vector<KeyValuePair*>& vecObjects = ndCurrent->objects();
 	  
-	  if(ckvpObjects) {
-	    std::list<KeyValuePair*> lstObjects = ckvpObjects->children();
-	    
+	  if(vecObjects.size() > 0) {
 	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpObject : lstObjects) {
+	    for(KeyValuePair* ckvpObject : vecObjects) {
 	      std::string strDefClass = ckvpObject->stringValue("_class");
 	      std::string strDefClassNamespace = ckvpObject->stringValue("_classnamespace");
 	      std::string strDefProperty = ckvpObject->stringValue("_property");
@@ -533,13 +531,11 @@ namespace semrec {
 	  }
 
 	  // Human references here.
-	  KeyValuePair* ckvpHumans = ndCurrent->metaInformation()->childForKey("humans");
+	  const std::vector<KeyValuePair*>& vecHumans = ndCurrent->humans();
 	  
-	  if(ckvpHumans) {
-	    std::list<KeyValuePair*> lstHumans = ckvpHumans->children();
-	    
+	  if(vecHumans.size() > 0) {
 	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpHuman : lstHumans) {
+	    for(KeyValuePair* ckvpHuman : vecHumans) {
 	      std::string strDefClass = ckvpHuman->stringValue("_class");
 	      std::string strDefClassNamespace = ckvpHuman->stringValue("_classnamespace");
 	      std::string strDefProperty = ckvpHuman->stringValue("_property");
@@ -562,68 +558,55 @@ namespace semrec {
 	  }
   
 	  // Image references here.
-	  KeyValuePair* ckvpImages = ndCurrent->metaInformation()->childForKey("images");
+	  const std::vector<NodeImage>& vecImages = ndCurrent->images();
 	  
-	  if(ckvpImages) {
-	    std::list<KeyValuePair*> lstImages = ckvpImages->children();
-	    
+	  if(vecImages.size() > 0) {
 	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpImage : lstImages) {
+	    for(const NodeImage& niImage : vecImages) {
 	      std::stringstream sts;
-	      sts << ndCurrent->uniqueID() << "_image_" << unIndex;
+	      sts << this->individualIDForNode(ndCurrent) << "_image_" << unIndex;
 	      
 	      oiIndividual.addResourceProperty("knowrob:capturedImage", "&" + strNamespace + ";" + sts.str());
 	    }
 	  }
 	  
 	  // Failure references here.
-	  KeyValuePair* ckvpFailures = ndCurrent->metaInformation()->childForKey("failures");
+	  const std::vector<NodeFailure>& vecFailures = ndCurrent->failures();
 	  
-	  if(ckvpFailures) {
-	    std::list<KeyValuePair*> lstFailures = ckvpFailures->children();
-	    
+	  if(vecFailures.size() > 0) {
 	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpFailure : lstFailures) {
+	    for(const NodeFailure& nfFailure : vecFailures) {
 	      std::stringstream sts;
-	      sts << ndCurrent->uniqueID() << "_failure_" << unIndex;
+	      sts << this->individualIDForNode(ndCurrent) << "_failure_" << unIndex;
 	      oiIndividual.addResourceProperty("knowrob:eventFailure", "&" + strNamespace + ";" + sts.str());
 	      m_nThrowAndCatchFailureCounter++;
 	    }
 	  }
 	  
 	  // Caught failure here.
-	  KeyValuePair* ckvpCaughtFailures = ndCurrent->metaInformation()->childForKey("caught_failures");
-	  
-	  if(ckvpCaughtFailures) {
-	    std::list<KeyValuePair*> lstCaughtFailures = ckvpCaughtFailures->children();
+	  for(const NodeCaughtFailure& ncfCaughtFailure : ndCurrent->caughtFailures()) {
+	    Node* ndFailureEmitter = ncfCaughtFailure.ndEmitter;
 	    
-	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpCaughtFailure : lstCaughtFailures) {
-	      Node* ndFailureEmitter = ndCurrent->emitterForCaughtFailure(ckvpCaughtFailure->stringValue("failure-id"), ckvpCaughtFailure->stringValue("emitter-id"), ckvpCaughtFailure->stringValue("time-catch"));
-	      
-	      if(ndFailureEmitter) {
-		std::string strCaughtFailure = ndFailureEmitter->uniqueID() + "_" + ckvpCaughtFailure->stringValue("failure-id");
-		m_nThrowAndCatchFailureCounter--;
-		oiIndividual.addResourceProperty("knowrob:caughtFailure", "&" + strNamespace + ";" + strCaughtFailure);
-	      } else {
-		this->warn("No emitter for failure '" + ckvpCaughtFailure->stringValue("failure-id") + "'.");
-	      }
+	    if(ndFailureEmitter) {
+	      std::string strCaughtFailure = this->individualIDForNode(ndFailureEmitter) + "_" + ncfCaughtFailure.strFailureID;
+	      m_nThrowAndCatchFailureCounter--;
+	      oiIndividual.addResourceProperty("knowrob:caughtFailure", "&" + strNamespace + ";" + strCaughtFailure);
+	    } else {
+	      SEMREC_WARN("No emitter for failure '" + ncfCaughtFailure.strFailureID + "'.");
 	    }
 	  }
 	  
 	  // Designator references here.
-	  KeyValuePair* ckvpDesignators = ndCurrent->metaInformation()->childForKey("designators");
+	  const std::vector<NodeDesignator>& vecDesignators = ndCurrent->designators();
 	  
-	  if(ckvpDesignators) {
-	    std::list<KeyValuePair*> lstDesignators = ckvpDesignators->children();
-	    
+	  if(vecDesignators.size() > 0) {
 	    unsigned int unIndex = 0;
-	    for(KeyValuePair* ckvpDesignator : lstDesignators) {
-	      std::string strAnnotation = ckvpDesignator->stringValue("annotation");
+	    for(const NodeDesignator& ndgDesignator : vecDesignators) {
+	      std::string strAnnotation = ndgDesignator.strAnnotation;
 	      std::string strDesigPurpose = this->resolveDesignatorAnnotationTagName(strAnnotation);
 	      
 	      if(strDesigPurpose == "speechActDetails") {
-		KeyValuePair* kvpSpeechAct = ckvpDesignator->childForKey("description");
+		KeyValuePair* kvpSpeechAct = ndgDesignator.ckvpDescription;
 		
 		std::string strSender = kvpSpeechAct->stringValue("sender");
 		std::string strReceiver = kvpSpeechAct->stringValue("receiver");
@@ -651,12 +634,12 @@ namespace semrec {
 		}
 	      }
 	      
-	      std::string strDesigID = ckvpDesignator->stringValue("id");
+	      std::string strDesigID = ndgDesignator.strID;
 	      
-	      m_mapDesignators[strDesigID] = ckvpDesignator;
+	      m_mapDesignators[strDesigID] = ndgDesignator;
 	      
 	      if(strAnnotation == "parameter-annotation") { // Special treatment for parameter annotations
-		KeyValuePair* ckvpChildren = ckvpDesignator->childForKey("description");
+		KeyValuePair* ckvpChildren = ndgDesignator.ckvpDescription;
 		
 		if(ckvpChildren) {
 		  for(KeyValuePair* ckvpChild : ckvpChildren->children()) {
@@ -674,7 +657,7 @@ namespace semrec {
 		      break;
 		      
 		    default:
-		      this->warn("Unsupported parameter annotation type for key '" + strKey + "'.");
+		      SEMREC_WARN("Unsupported parameter annotation type for key '" + strKey + "'.");
 		      bSupportedType = false;
 		      break;
 		    }
@@ -684,11 +667,7 @@ namespace semrec {
 			m_lstAnnotatedParameters.push_back(strKey);
 		      }
 		      
-		      std::string strNamespace = ckvpDesignator->stringValue("namespace");
-		      
-		      if(strNamespace == "") {
-			strNamespace = "knowrob";
-		      }
+		      std::string strNamespace = "knowrob";
 		      
 		      oiIndividual.addContentProperty(strNamespace + ":" + strKey, sts.str());
 		      oiIndividual.addDataProperty("knowrob:annotatedParameterType", "&xsd;string", strKey);
@@ -699,7 +678,7 @@ namespace semrec {
 		std::string strDesigPurpose = this->resolveDesignatorAnnotationTagName(strAnnotation);
 		oiIndividual.addResourceProperty("knowrob:" + strDesigPurpose, "&" + strNamespace + ";" + strDesigID);
 	      } else if(strAnnotation == "resource-annotation") {
-		KeyValuePair* ckvpChildren = ckvpDesignator->childForKey("description");
+		KeyValuePair* ckvpChildren = ndgDesignator.ckvpDescription;
 		
 		if(ckvpChildren) {
 		  std::string strNamespace = ckvpChildren->stringValue("namespace");
@@ -721,18 +700,14 @@ namespace semrec {
 		  }
 		}		
 	      } else {
-		std::string strNamespace = ckvpDesignator->stringValue("namespace");
-		
-		if(strNamespace == "") {
-		  strNamespace = "knowrob";
-		}
+		std::string strNamespace = "knowrob";
 		
 		oiIndividual.addResourceProperty("knowrob:" + strDesigPurpose, "&" + strNamespace + ";" + strDesigID);
 	      }
 	    }
 	  }
 	  
-	  strDot += oiIndividual.print();
+	  oiIndividual.print(osOwl);
 	  
 	  ndLastDisplayed = ndCurrent;
 	}
@@ -740,8 +715,6 @@ namespace semrec {
 	this->fail("Generation of event individual for node with invalid content requested!");
       }
     }
-    
-    return strDot;
   }
   
   std::string CExporterOwl::resolveDesignatorAnnotationTagName(std::string strAnnotation) {
@@ -761,11 +734,9 @@ namespace semrec {
     return strDesigPurpose;
   }
   
-  std::string CExporterOwl::generateEventIndividuals(std::string strNamespace) {
-    std::string strDot = "    <!-- Event Individuals -->\n\n";
-    strDot += this->generateEventIndividualsForNodes(this->nodes(), strNamespace);
-    
-    return strDot;
+  void CExporterOwl::generateEventIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Event Individuals -->\n\n";
+    this->generateEventIndividualsForNodes(this->nodes(), strNamespace, osOwl, ovIssued);
   }
   
   std::string CExporterOwl::owlClassForObject(KeyValuePair *ckvpObject) {
@@ -789,262 +760,247 @@ namespace semrec {
     return strFailureClass;
   }
   
-  std::string CExporterOwl::generateFailureIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace) {
-    std::string strDot = "";
+  void CExporterOwl::generateIndividualsForNodes(const std::vector<Node*>& vecNodes, NodeIndividualsGenerator nigGenerate, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive) {
+    class IndividualsVisitor : public NodeVisitor {
+    public:
+      CExporterOwl* m_expOwl;
+      NodeIndividualsGenerator m_nigGenerate;
+      std::string m_strNamespace;
+      OutputSink* m_osOwl;
+      OwlVocabulary* m_ovIssued;
+      bool m_bRecursive;
+      
+      bool enterNode(Node* ndNode) {
+	if(m_expOwl->nodeSpooled(ndNode)) {
+	  // Written (with its whole subtree) while spooling.
+	  return false;
+	}
+	
+	(m_expOwl->*m_nigGenerate)(ndNode, m_strNamespace, *m_osOwl, *m_ovIssued);
+	
+	return m_bRecursive;
+      }
+    } ivVisitor;
+    
+    ivVisitor.m_expOwl = this;
+    ivVisitor.m_nigGenerate = nigGenerate;
+    ivVisitor.m_strNamespace = strNamespace;
+    ivVisitor.m_osOwl = &osOwl;
+    ivVisitor.m_ovIssued = &ovIssued;
+    ivVisitor.m_bRecursive = bRecursive;
     
-    for(Node* ndCurrent : lstNodes) {
+    for(Node* ndCurrent : vecNodes) {
       if(ndCurrent) {
-	KeyValuePair *ckvpFailures = ndCurrent->metaInformation()->childForKey("failures");
+	ndCurrent->accept(ivVisitor);
+      } else {
+	this->fail("Generation of individuals for node with invalid content requested!");
+      }
+    }
+  }
+  
+  void CExporterOwl::generateFailureIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive) {
+    this->generateIndividualsForNodes(vecNodes, &CExporterOwl::generateFailureIndividualsForNode, strNamespace, osOwl, ovIssued, bRecursive);
+  }
+  
+  void CExporterOwl::generateFailureIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    const std::vector<NodeFailure>& vecFailures = ndCurrent->failures();
+    
+    if(vecFailures.size() > 0) {
+      unsigned int unIndex = 0;
+      for(const NodeFailure& nfFailure : vecFailures) {
+	std::stringstream sts;
+	sts << this->individualIDForNode(ndCurrent) << "_failure_" << unIndex;
 	
-	if(ckvpFailures) {
-	  std::list<KeyValuePair*> lstFailures = ckvpFailures->children();
-	  
-	  unsigned int unIndex = 0;
-	  for(KeyValuePair* ckvpFailure : lstFailures) {
-	    std::stringstream sts;
-	    sts << ndCurrent->uniqueID() << "_failure_" << unIndex;
-	    
-	    std::string strCondition = ckvpFailure->stringValue("condition");
-	    std::string strTimestamp = ckvpFailure->stringValue("time-fail");
-	    
-	    std::string strFailureClass = this->failureClassForCondition(strCondition);
-	    
-	    OwlIndividual oiIndividual;
-	    oiIndividual.setID("&" + strNamespace + ";" + sts.str());
-	    oiIndividual.setType("&knowrob;" + strFailureClass);
-	    oiIndividual.addDataProperty("rdfs:label", "&xsd;string", this->owlEscapeString(strCondition));
-	    oiIndividual.addResourceProperty("knowrob:startTime", "&" + strNamespace + ";timepoint_" + strTimestamp);
-	    
-	    strDot += oiIndividual.print();
-	  }
-	}
+	std::string strCondition = nfFailure.strCondition;
+	std::string strTimestamp = nfFailure.strTimeFail;
 	
-	strDot += this->generateFailureIndividualsForNodes(ndCurrent->subnodes(), strNamespace);
-      } else {
-	this->fail("Failure node with invalid content!");
+	std::string strFailureClass = this->failureClassForCondition(strCondition);
+	
+	OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
+	oiIndividual.setID("&" + strNamespace + ";" + sts.str());
+	oiIndividual.setType("&knowrob;" + strFailureClass);
+	oiIndividual.addDataProperty("rdfs:label", "&xsd;string", this->owlEscapeString(strCondition));
+	oiIndividual.addResourceProperty("knowrob:startTime", "&" + strNamespace + ";timepoint_" + strTimestamp);
+	
+	oiIndividual.print(osOwl);
       }
     }
-    
-    return strDot;
   }
   
-  std::string CExporterOwl::generateHumanIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace) {
-    std::string strDot = "";
+  void CExporterOwl::generateHumanIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive) {
+    this->generateIndividualsForNodes(vecNodes, &CExporterOwl::generateHumanIndividualsForNode, strNamespace, osOwl, ovIssued, bRecursive);
+  }
+  
+  void CExporterOwl::generateHumanIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    const std::vector<KeyValuePair*>& vecHumans = ndCurrent->humans();
     
-    for(Node* ndCurrent : lstNodes) {
-      if(ndCurrent) {
-	KeyValuePair* ckvpHumans = ndCurrent->metaInformation()->childForKey("humans");
+    if(vecHumans.size() > 0) {
+      unsigned int unIndex = 0;
+      for(KeyValuePair* ckvpHuman : vecHumans) {
+	std::string strDesignatorID = ckvpHuman->stringValue("__id");
 	
-	if(ckvpHumans) {
-	  std::list<KeyValuePair*> lstHumans = ckvpHumans->children();
-	  
-	  unsigned int unIndex = 0;
-	  for(KeyValuePair* ckvpHuman : lstHumans) {
-	    std::string strDesignatorID = ckvpHuman->stringValue("__id");
-	    
-	    std::string strDefClass = ckvpHuman->stringValue("_class");
-	    std::string strDefClassNamespace = ckvpHuman->stringValue("_classnamespace");
-	    
-	    std::string strOwlClass = strDefClass;
-	    if(strOwlClass == "") {
-	      strOwlClass = this->owlClassForHuman(ckvpHuman);
-	    } else {
-	      strOwlClass = strDefClassNamespace + strDefClass;
-	    }
-	    
-	    if(strDefClass == "") {
-	      strDefClass = "human";
-	    }
-	    
-	    if(strDefClassNamespace == "") {
-	      strDefClassNamespace = "&" + strNamespace + ";";
-	    }
-	    
-	    std::string strHumanID = strDefClass + "_" + ckvpHuman->stringValue("__id");
-	    
-	    if(find(m_lstExportedHumanIndividuals.begin(), m_lstExportedHumanIndividuals.end(), strHumanID) == m_lstExportedHumanIndividuals.end()) {
-	      OwlIndividual oiIndividual;
-	      oiIndividual.setID(strDefClassNamespace + strHumanID);
-	      oiIndividual.setType(strOwlClass);
-	      oiIndividual.addResourceProperty("knowrob:designator", "&" + strNamespace + ";" + strDesignatorID);
+	std::string strDefClass = ckvpHuman->stringValue("_class");
+	std::string strDefClassNamespace = ckvpHuman->stringValue("_classnamespace");
+	
+	std::string strOwlClass = strDefClass;
+	if(strOwlClass == "") {
+	  strOwlClass = this->owlClassForHuman(ckvpHuman);
+	} else {
+	  strOwlClass = strDefClassNamespace + strDefClass;
+	}
+	
+	if(strDefClass == "") {
+	  strDefClass = "human";
+	}
+	
+	if(strDefClassNamespace == "") {
+	  strDefClassNamespace = "&" + strNamespace + ";";
+	}
+	
+	std::string strHumanID = strDefClass + "_" + ckvpHuman->stringValue("__id");
+	
+	if(ovIssued.issueIndividual(strHumanID)) {
+	  OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
+	  oiIndividual.setID(strDefClassNamespace + strHumanID);
+	  oiIndividual.setType(strOwlClass);
+	  oiIndividual.addResourceProperty("knowrob:designator", "&" + strNamespace + ";" + strDesignatorID);
 
-              if(ckvpHuman->childForKey("_srdlcomponent")) {
-       	        oiIndividual.addResourceProperty("srdl2-comp:subComponent", ckvpHuman->stringValue("_srdlcomponent"));
-              }
-	      
-	      if(ckvpHuman->childForKey("_tfprefix")) {
-		oiIndividual.addDataProperty("srdl2-comp:tfPrefix", "&xsd;string", ckvpHuman->stringValue("_tfprefix"));
-	      }
-	      
-	      strDot += oiIndividual.print();
-	      
-	      m_lstExportedHumanIndividuals.push_back(strHumanID);
-	    }
+	  if(ckvpHuman->childForKey("_srdlcomponent")) {
+	    oiIndividual.addResourceProperty("srdl2-comp:subComponent", ckvpHuman->stringValue("_srdlcomponent"));
 	  }
+	  
+	  if(ckvpHuman->childForKey("_tfprefix")) {
+	    oiIndividual.addDataProperty("srdl2-comp:tfPrefix", "&xsd;string", ckvpHuman->stringValue("_tfprefix"));
+	  }
+	  
+	  oiIndividual.print(osOwl);
 	}
-	
-	strDot += this->generateHumanIndividualsForNodes(ndCurrent->subnodes(), strNamespace);
-      } else {
-	this->fail("Generation of human individual for node with invalid content requested!");
       }
     }
-    
-    return strDot;
   }
   
-  std::string CExporterOwl::generateHumanIndividuals(std::string strNamespace) {
-    std::string strDot = "    <!-- Human Individuals -->\n\n";
-    strDot += this->generateHumanIndividualsForNodes(this->nodes(), strNamespace);
-    
-    return strDot;
+  void CExporterOwl::generateHumanIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Human Individuals -->\n\n";
+    this->generateHumanIndividualsForNodes(this->nodes(), strNamespace, osOwl, ovIssued);
   }
 
-  std::string CExporterOwl::generateObjectIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace) {
-    std::string strDot = "";
+  void CExporterOwl::generateObjectIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive) {
+    this->generateIndividualsForNodes(vecNodes, &CExporterOwl::generateObjectIndividualsForNode, strNamespace, osOwl, ovIssued, bRecursive);
+  }
+  
+  void CExporterOwl::generateObjectIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    const std::vector<KeyValuePair*>& vecObjects = ndCurrent->objects();
     
-    for(Node* ndCurrent : lstNodes) {
-      if(ndCurrent) {
-	KeyValuePair* ckvpObjects = ndCurrent->metaInformation()->childForKey("objects");
+    if(vecObjects.size() > 0) {
+      unsigned int unIndex = 0;
+      for(KeyValuePair* ckvpObject : vecObjects) {
+	std::string strDesignatorID = ckvpObject->stringValue("__id");
+	
+	std::string strDefClass = ckvpObject->stringValue("_class");
+	std::string strDefClassNamespace = ckvpObject->stringValue("_classnamespace");
 	
-	if(ckvpObjects) {
-	  std::list<KeyValuePair*> lstObjects = ckvpObjects->children();
+	std::string strOwlClass = strDefClass;
+	if(strOwlClass == "") {
+	  strOwlClass = this->owlClassForObject(ckvpObject);
+	} else {
+	  strOwlClass = strDefClassNamespace + strDefClass;
+	}
+	
+	if(strDefClass == "") {
+	  strDefClass = "object";
+	}
+	
+	if(strDefClassNamespace == "") {
+	  strDefClassNamespace = "&" + strNamespace + ";";
+	}
+	
+	std::string strObjectID = strDefClass + "_" + ckvpObject->stringValue("__id");
+	
+	if(ovIssued.issueIndividual(strObjectID)) {
+	  OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
+	  oiIndividual.setID(strDefClassNamespace + strObjectID);
+	  oiIndividual.setType(strOwlClass);
+	  oiIndividual.addResourceProperty("knowrob:designator", "&" + strNamespace + ";" + strDesignatorID);
 	  
-	  unsigned int unIndex = 0;
-	  for(KeyValuePair* ckvpObject : lstObjects) {
-	    std::string strDesignatorID = ckvpObject->stringValue("__id");
-	    
-	    std::string strDefClass = ckvpObject->stringValue("_class");
-	    std::string strDefClassNamespace = ckvpObject->stringValue("_classnamespace");
-	    
-	    std::string strOwlClass = strDefClass;
-	    if(strOwlClass == "") {
-	      strOwlClass = this->owlClassForObject(ckvpObject);
-	    } else {
-	      strOwlClass = strDefClassNamespace + strDefClass;
-	    }
-	    
-	    if(strDefClass == "") {
-	      strDefClass = "object";
-	    }
-	    
-	    if(strDefClassNamespace == "") {
-	      strDefClassNamespace = "&" + strNamespace + ";";
-	    }
-	    
-	    std::string strObjectID = strDefClass + "_" + ckvpObject->stringValue("__id");
-	    
-	    if(find(m_lstExportedObjectIndividuals.begin(), m_lstExportedObjectIndividuals.end(), strObjectID) == m_lstExportedObjectIndividuals.end()) {
-	      OwlIndividual oiIndividual;
-	      oiIndividual.setID(strDefClassNamespace + strObjectID);
-	      oiIndividual.setType(strOwlClass);
-	      oiIndividual.addResourceProperty("knowrob:designator", "&" + strNamespace + ";" + strDesignatorID);
-	      
-	      if(ckvpObject->childForKey("path-to-cad-model")) {
-		oiIndividual.addDataProperty("knowrob:pathToCadModel", "&xsd;string", ckvpObject->stringValue("path-to-cad-model"));
-	      }
-	      
-	      strDot += oiIndividual.print();
-	      
-	      m_lstExportedObjectIndividuals.push_back(strObjectID);
-	    }
+	  if(ckvpObject->childForKey("path-to-cad-model")) {
+	    oiIndividual.addDataProperty("knowrob:pathToCadModel", "&xsd;string", ckvpObject->stringValue("path-to-cad-model"));
 	  }
+	  
+	  oiIndividual.print(osOwl);
 	}
-	
-	strDot += this->generateObjectIndividualsForNodes(ndCurrent->subnodes(), strNamespace);
-      } else {
-	this->fail("Generation of object individual for node with invalid content requested!");
       }
     }
-    
-    return strDot;
   }
   
-  std::string CExporterOwl::generateObjectIndividuals(std::string strNamespace) {
-    std::string strDot = "    <!-- Object Individuals -->\n\n";
-    strDot += this->generateObjectIndividualsForNodes(this->nodes(), strNamespace);
-    
-    return strDot;
+  void CExporterOwl::generateObjectIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Object Individuals -->\n\n";
+    this->generateObjectIndividualsForNodes(this->nodes(), strNamespace, osOwl, ovIssued);
   }
   
-  std::string CExporterOwl::generateImageIndividualsForNodes(std::list<Node*> lstNodes, std::string strNamespace) {
-    std::string strDot = "";
-    
-    for(Node* ndCurrent : lstNodes) {
-      if(ndCurrent) {
-	KeyValuePair* ckvpImages = ndCurrent->metaInformation()->childForKey("images");
+  void CExporterOwl::generateImageIndividualsForNodes(const std::vector<Node*>& vecNodes, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued, bool bRecursive) {
+    this->generateIndividualsForNodes(vecNodes, &CExporterOwl::generateImageIndividualsForNode, strNamespace, osOwl, ovIssued, bRecursive);
+  }
+  
+  void CExporterOwl::generateImageIndividualsForNode(Node* ndCurrent, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    const std::vector<NodeImage>& vecImages = ndCurrent->images();
+    
+    if(vecImages.size() > 0) {
+      unsigned int unIndex = 0;
+      for(const NodeImage& niImage : vecImages) {
+	std::stringstream sts;
+	sts << this->individualIDForNode(ndCurrent) << "_image_" << unIndex;
 	
-	if(ckvpImages) {
-	  std::list<KeyValuePair*> lstImages = ckvpImages->children();
-	  
-	  unsigned int unIndex = 0;
-	  for(KeyValuePair* ckvpImage : lstImages) {
-	    std::stringstream sts;
-	    sts << ndCurrent->uniqueID() << "_image_" << unIndex;
-	    
-	    std::string strOwlClass = "&knowrob;CameraImage";
-	    std::string strFilename = ckvpImage->stringValue("filename");
-	    std::string strTopic = ckvpImage->stringValue("origin");
-	    std::string strCaptureTime = ckvpImage->stringValue("time-capture");
-	    
-	    OwlIndividual oiIndividual;
-	    oiIndividual.setID("&" + strNamespace + ";" + sts.str());
-	    oiIndividual.setType(strOwlClass);
-	    oiIndividual.addDataProperty("knowrob:linkToImageFile", "&xsd;string", strFilename);
-	    oiIndividual.addDataProperty("knowrob:rosTopic", "&xsd;string", strTopic);
-	    oiIndividual.addResourceProperty("knowrob:captureTime", "&" + strNamespace + ";timepoint_" + strCaptureTime);
-	    
-	    strDot += oiIndividual.print();
-	  }
-	}
+	std::string strOwlClass = "&knowrob;CameraImage";
+	std::string strFilename = niImage.strFilename;
+	std::string strTopic = niImage.strOrigin;
+	std::string strCaptureTime = niImage.strTimeCapture;
 	
-	strDot += this->generateImageIndividualsForNodes(ndCurrent->subnodes(), strNamespace);
-      } else {
-	this->fail("Image node with invalid content!");
+	OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
+	oiIndividual.setID("&" + strNamespace + ";" + sts.str());
+	oiIndividual.setType(strOwlClass);
+	oiIndividual.addDataProperty("knowrob:linkToImageFile", "&xsd;string", strFilename);
+	oiIndividual.addDataProperty("knowrob:rosTopic", "&xsd;string", strTopic);
+	oiIndividual.addResourceProperty("knowrob:captureTime", "&" + strNamespace + ";timepoint_" + strCaptureTime);
+	
+	oiIndividual.print(osOwl);
       }
     }
-    
-    return strDot;
   }
   
-  std::string CExporterOwl::generateImageIndividuals(std::string strNamespace) {
-    std::string strDot = "    <!-- Image Individuals -->\n\n";
-    
-    strDot += this->generateImageIndividualsForNodes(this->nodes(), strNamespace);
+  void CExporterOwl::generateImageIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Image Individuals -->\n\n";
     
-    return strDot;
+    this->generateImageIndividualsForNodes(this->nodes(), strNamespace, osOwl, ovIssued);
   }
   
-  std::string CExporterOwl::generateDesignatorIndividuals(std::string strNamespace) {
-    std::string strDot = "    <!-- Designator Individuals -->\n\n";
+  void CExporterOwl::generateDesignatorIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Designator Individuals -->\n\n";
     
-    std::list<std::string> lstDesigIDs = this->designatorIDs();
-    
-    for(std::string strID : lstDesigIDs) {
-      OwlIndividual oiIndividual;
+    for(std::string strID : this->designatorIDs()) {
+      OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
       oiIndividual.setID("&" + strNamespace + ";" + strID);
 
       std::string strDesignatorClass = m_strDefaultDesignatorClass;
+      std::map<std::string, NodeDesignator>::const_iterator itDesignator = m_mapDesignators.find(strID);
       
-      if(m_mapDesignators.find(strID) != m_mapDesignators.end()) {
-	if(m_mapDesignators[strID]) {
-	  if(m_mapDesignators[strID]->childForKey("type")) {
-	    if(m_mapDesignators[strID]->stringValue("type") == "ACTION") {
-	      strDesignatorClass = "CRAMActionDesignator";
-	    } else if(m_mapDesignators[strID]->stringValue("type") == "LOCATION") {
-	      strDesignatorClass = "CRAMLocationDesignator";
-	    } else if(m_mapDesignators[strID]->stringValue("type") == "HUMAN") {
-	      strDesignatorClass = "CRAMHumanDesignator";
-	    } else if(m_mapDesignators[strID]->stringValue("type") == "OBJECT") {
-	      strDesignatorClass = "CRAMObjectDesignator";
-	    }
-	  }
+      if(itDesignator != m_mapDesignators.end()) {
+	std::string strType = itDesignator->second.strType;
+	
+	if(strType == "ACTION") {
+	  strDesignatorClass = "CRAMActionDesignator";
+	} else if(strType == "LOCATION") {
+	  strDesignatorClass = "CRAMLocationDesignator";
+	} else if(strType == "HUMAN") {
+	  strDesignatorClass = "CRAMHumanDesignator";
+	} else if(strType == "OBJECT") {
+	  strDesignatorClass = "CRAMObjectDesignator";
 	}
       }
       
       oiIndividual.setType("&knowrob;" + strDesignatorClass);
       
-      if(m_mapDesignators.find(strID) != m_mapDesignators.end()) {
-	std::string strTimeCreated = m_mapDesignators[strID]->childForKey("description")->stringValue("_time_created");
+      if(itDesignator != m_mapDesignators.end()) {
+	std::string strTimeCreated = itDesignator->second.ckvpDescription->stringValue("_time_created");
 	oiIndividual.addResourceProperty("knowrob:creationTime", "&" + strNamespace + ";timepoint_" + strTimeCreated);
       }
       
@@ -1062,7 +1018,7 @@ namespace semrec {
       // chain') when a) there are successors, and b) it does not have
       // an equation time.
       if(lstSuccessorIDs.size() > 0 && strEquationTime == "") {
-	strDot += "    <!-- This is an index designator -->\n";
+	osOwl << "    <!-- This is an index designator -->\n";
 	
 	std::list<std::string> lstAllSuccessors = this->collectAllSuccessorDesignatorIDs(strID);
 	for(std::string strSuccessor : lstAllSuccessors) {
@@ -1070,101 +1026,119 @@ namespace semrec {
 	}
       }
       
-      strDot += oiIndividual.print();
+      oiIndividual.print(osOwl);
     }
-    
-    return strDot;
   }
   
   std::list<std::string> CExporterOwl::collectAllSuccessorDesignatorIDs(std::string strDesigID) {
-    std::list<std::string> lstReturn;
-    std::list<std::string> lstSuccessors = this->successorDesignatorsForID(strDesigID);
+    std::vector<std::string> vecSuccessors = this->designatorRegistry().successorClosure(strDesigID);
+    
+    return std::list<std::string>(vecSuccessors.begin(), vecSuccessors.end());
+  }
+  
+  void CExporterOwl::generateFailureIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Failure Individuals -->\n\n";
+    this->generateFailureIndividualsForNodes(this->nodes(), strNamespace, osOwl, ovIssued);
+  }
+  
+  static bool parseTimepoint(const std::string& strTimepoint, double& dTime) {
+    const char* acStart = strTimepoint.c_str();
+    char* acEnd = NULL;
+    
+    dTime = strtod(acStart, &acEnd);
     
-    for(std::string strSuccessor : lstSuccessors) {
-      std::list<std::string> lstSubSuccessors = this->collectAllSuccessorDesignatorIDs(strSuccessor);
+    return acEnd != acStart;
+  }
+  
+  void CExporterOwl::widenTimeSpan(TimeSpan& tsSpan, std::string strTimepoint) {
+    double dTime;
+    
+    if(parseTimepoint(strTimepoint, dTime)) {
+      if(!tsSpan.bTimed || dTime < tsSpan.dEarliest) {
+	tsSpan.dEarliest = dTime;
+	tsSpan.strEarliest = strTimepoint;
+      }
       
-      for(std::string strSubSuccessor : lstSubSuccessors) {
-	lstReturn.push_back(strSubSuccessor);
+      if(!tsSpan.bTimed || dTime > tsSpan.dLatest) {
+	tsSpan.dLatest = dTime;
+	tsSpan.strLatest = strTimepoint;
       }
       
-      lstReturn.push_back(strSuccessor);
+      tsSpan.bTimed = true;
     }
-    
-    return lstReturn;
   }
   
-  std::string CExporterOwl::generateFailureIndividuals(std::string strNamespace) {
-    std::string strDot = "    <!-- Failure Individuals -->\n\n";
-    strDot += this->generateFailureIndividualsForNodes(this->nodes(), strNamespace);
-    
-    return strDot;
+  void CExporterOwl::generateTimepointIndividualsFor(const std::vector<std::string>& vecTimepoints, TimeSpan& tsSpan, std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    // Unify all timepoints, keeping the order of their first
+    // occurrence. They stay strings, as the other individuals
+    // reference them by their exact textual representation.
+    for(const std::string& strTimepoint : vecTimepoints) {
+      if(!ovIssued.issueIndividual("timepoint_" + strTimepoint)) {
+	continue;
+      }
+      
+      OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
+      oiIndividual.setID("&" + strNamespace + ";timepoint_" + strTimepoint);
+      oiIndividual.setType("&knowrob;TimePoint");
+      
+      oiIndividual.print(osOwl);
+      
+      this->widenTimeSpan(tsSpan, strTimepoint);
+    }
   }
   
-  std::string CExporterOwl::generateTimepointIndividuals(std::string strNamespace) {
-    std::string strDot = "    <!-- Timepoint Individuals -->\n\n";
+  void CExporterOwl::generateTimepointIndividuals(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Timepoint Individuals -->\n\n";
+    
+    std::vector<std::string> vecTimepoints;
+    this->gatherTimepointsForNodes(this->nodes(), vecTimepoints);
     
-    std::list<Node*> lstTrace;
-    std::list<std::string> lstTimepoints = this->gatherTimepointsForNodes(this->nodes(), lstTrace);
+    // NOTE: These don't depend on the individual nodes, so
+    // they are only gathered once (as long as there are nodes at
+    // all).
+    if(vecTimepoints.size() > 0) {
+      this->gatherDesignatorTimepoints(vecTimepoints);
+    }
     
-    // Unify all timepoints
-    std::list<std::string> lstTimepointsUnified;
-    this->info("      Acquired " + this->str((int)lstTimepoints.size()) + " timepoint(s) for unification.");
+    SEMREC_INFO("      Acquired " + this->str((int)vecTimepoints.size()) + " timepoint(s) for unification.");
     
-    for(std::string strTimepoint : lstTimepoints) {
-      if(std::find(lstTimepointsUnified.begin(), lstTimepointsUnified.end(), strTimepoint) == lstTimepointsUnified.end()) {
-	lstTimepointsUnified.push_back(strTimepoint);
-      }
+    // Spooled timepoints were written already; ovIssued knows them.
+    TimeSpan tsSpan = {"", "", 0.0, 0.0, false};
+    if(this->useSpool()) {
+      tsSpan = m_tsSpooled;
     }
+    this->generateTimepointIndividualsFor(vecTimepoints, tsSpan, strNamespace, osOwl, ovIssued);
     
     this->info("      Unification complete.");
     
-    for(std::string strTimepoint : lstTimepointsUnified) {
-      OwlIndividual oiIndividual;
-      oiIndividual.setID("&" + strNamespace + ";timepoint_" + strTimepoint);
-      oiIndividual.setType("&knowrob;TimePoint");
-      
-      strDot += oiIndividual.print();
+    // Only widen the time span the meta data may already define.
+    if(tsSpan.bTimed) {
+      double dTimeOld;
+      std::map<std::string, MappedMetaData>::iterator itStart = m_mapMetaData.find("time-start");
       
-      // Find earliest and latest timepoint
-      if(m_mapMetaData.find("time-start") == m_mapMetaData.end()) {
-	m_mapMetaData["time-start"] = {MappedMetaData::Property, strTimepoint};
-      } else {
-	float fTimeNew, fTimeOld;
-	sscanf(strTimepoint.c_str(), "%f", &fTimeNew);
-	sscanf(m_mapMetaData["time-start"].strValue.c_str(), "%f", &fTimeOld);
-	
-	if(fTimeNew < fTimeOld) {
-	  m_mapMetaData["time-start"] = {MappedMetaData::Property, strTimepoint};
-	}
+      if(itStart == m_mapMetaData.end() || !parseTimepoint(itStart->second.strValue, dTimeOld) || tsSpan.dEarliest < dTimeOld) {
+	m_mapMetaData["time-start"] = {MappedMetaData::Property, tsSpan.strEarliest};
       }
       
-      if(m_mapMetaData.find("time-end") == m_mapMetaData.end()) {
-	m_mapMetaData["time-end"] = {MappedMetaData::Property, strTimepoint};
-      } else {
-	float fTimeNew, fTimeOld;
-	sscanf(strTimepoint.c_str(), "%f", &fTimeNew);
-	sscanf(m_mapMetaData["time-end"].strValue.c_str(), "%f", &fTimeOld);
-	
-	if(fTimeNew > fTimeOld) {
-	  m_mapMetaData["time-end"] = {MappedMetaData::Property, strTimepoint};
-	}
+      std::map<std::string, MappedMetaData>::iterator itEnd = m_mapMetaData.find("time-end");
+      
+      if(itEnd == m_mapMetaData.end() || !parseTimepoint(itEnd->second.strValue, dTimeOld) || tsSpan.dLatest > dTimeOld) {
+	m_mapMetaData["time-end"] = {MappedMetaData::Property, tsSpan.strLatest};
       }
     }
-    
-    return strDot;
   }
   
-  std::string CExporterOwl::generateMetaDataIndividual(std::string strNamespace) {
-    std::string strDot = "    <!-- Meta Data Individual -->\n\n";
+  void CExporterOwl::generateMetaDataIndividual(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Meta Data Individual -->\n\n";
     std::string strUniqueName = this->generateUniqueID("RobotExperiment_");
     
-    OwlIndividual oiIndividual;
+    OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
     oiIndividual.setID("&" + strNamespace + ";" + strUniqueName);
     oiIndividual.setType("&knowrob;RobotExperiment");
     
     std::list<Node*> lstRootNodes = this->rootNodes();
     for(Node* ndRoot : lstRootNodes) {
-      oiIndividual.addResourceProperty("knowrob:subAction", "&" + strNamespace + ";" + ndRoot->uniqueID());
+      oiIndividual.addResourceProperty("knowrob:subAction", "&" + strNamespace + ";" + this->individualIDForNode(ndRoot));
     }
     
     for(std::pair<std::string, MappedMetaData> prEntry : m_mapMetaData) {
@@ -1198,16 +1172,14 @@ namespace semrec {
       }
     }
     
-    strDot += oiIndividual.print();
-    
-    return strDot;
+    oiIndividual.print(osOwl);
   }
   
-  std::string CExporterOwl::generateParameterAnnotationInformation(std::string strNamespace) {
-    std::string strDot = "    <!-- Parameter Annotation Information Individual -->\n\n";
+  void CExporterOwl::generateParameterAnnotationInformation(std::string strNamespace, OutputSink& osOwl, OwlVocabulary& ovIssued) {
+    osOwl << "    <!-- Parameter Annotation Information Individual -->\n\n";
     std::string strUniqueName = this->generateUniqueID("AnnotationInformation_");
     
-    OwlIndividual oiIndividual;
+    OwlIndividual oiIndividual(ovIssued, &m_ospStatic);
     oiIndividual.setID("&" + strNamespace + ";" + strUniqueName);
     oiIndividual.setType("&knowrob;AnnotationInformation");
     
@@ -1215,9 +1187,7 @@ namespace semrec {
       oiIndividual.addDataProperty("knowrob:annotatedParameterType", "&xsd;string", strParameterAnnotation);
     }
     
-    strDot += oiIndividual.print();
-    
-    return strDot;
+    oiIndividual.print(osOwl);
   }
   
   std::string CExporterOwl::owlClassForNode(Node *ndNode, bool bClassOnly, bool bPrologSyntax) {
@@ -1401,35 +1371,42 @@ namespace semrec {
   }
   
   bool CExporterOwl::runExporter(KeyValuePair* ckvpConfigurationOverlay) {
-    m_lstAnnotatedParameters.clear();
-    m_lstExportedObjectIndividuals.clear();
-    m_lstExportedHumanIndividuals.clear();
-   
-    m_nThrowAndCatchFailureCounter = 0;
-    
-    this->info("Renewing unique IDs");
-    this->renewUniqueIDs();
+    if(this->useSpool()) {
+      // Continue from what the spooled individuals collected; the
+      // spooled state itself stays untouched for later exports.
+      m_mapDesignators = m_mapSpooledDesignators;
+      m_lstAnnotatedParameters = m_lstSpooledAnnotatedParameters;
+      m_nThrowAndCatchFailureCounter = m_nSpooledThrowAndCatchFailureCounter;
+      
+      this->info("Assigning IDs to nodes not spooled yet");
+      this->assignIndividualIDs(this->nodes());
+    } else if(m_bSpooling) {
+      // Everything is generated, but with the IDs the spooled
+      // individuals got, so the result is comparable.
+      m_mapDesignators.clear();
+      m_lstAnnotatedParameters.clear();
+      m_nThrowAndCatchFailureCounter = 0;
+      
+      this->info("Assigning IDs to all nodes, ignoring the spool");
+      this->assignIndividualIDs(this->nodes());
+    } else {
+      m_mapDesignators.clear();
+      m_lstAnnotatedParameters.clear();
+      m_nThrowAndCatchFailureCounter = 0;
+      
+      this->info("Renewing unique IDs");
+      this->renewUniqueIDs();
+    }
     
     this->info("Generating XML");
     if(this->outputFilename() != "") {
-      std::string strOwl = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n\n";
-      // NOTE(winkler): This used to be `random'. Changed this due to
-      // non-necessity of such a long namespace.
-      // this->generateRandomIdentifier("namespace_", 8);
-      std::string strNamespaceID = "log";
-      std::string strNamespace = "http://knowrob.org/kb/cram_log.owl";// + strNamespaceID;
-      
       // Prepare content
       this->info(" - Preparing content");
-      this->prepareEntities(strNamespaceID, strNamespace);
+      this->prepareEntities(m_strNamespaceID, m_strNamespace);
       
-      // Generate source
+      // Generate source and write the .owl file
       this->info(" - Generating source");
-      strOwl += this->generateOwlStringForNodes(this->nodes(), strNamespaceID, strNamespace);
-      
-      // Write the .owl file
-      this->info(" - Writing file");
-      return this->writeToFile(strOwl);
+      return this->writeOwlFile(this->outputFilename(), m_strNamespaceID, m_strNamespace);
     } else {
       this->fail("No output filename was given. Cancelling.");
     }
@@ -1441,55 +1418,369 @@ namespace semrec {
     return strValue;
   }
   
-  std::string CExporterOwl::generateOwlStringForNodes(std::list<Node*> lstNodes, std::string strNamespaceID, std::string strNamespace) {
-    std::string strOwl = "";
-    OwlIndividual::resetIssuedInformation();
-    
-    // Assemble OWL source
+  void CExporterOwl::generateOwlHead(std::string strNamespace, const OwlVocabulary& ovIssued, OutputSink& osOwl) {
     this->info("   - Block: DocType");
-    strOwl += this->generateDocTypeBlock();
+    this->generateDocTypeBlock(osOwl);
     this->info("   - Block: XMLNS");
-    strOwl += this->generateXMLNSBlock(strNamespace);
+    this->generateXMLNSBlock(strNamespace, osOwl);
     this->info("   - Block: Imports");
-    strOwl += this->generateOwlImports(strNamespace);
-    
-    std::string strOwl2 = "";
-    this->info("   - Block: Event Individuals");
-    strOwl2 += this->generateEventIndividuals(strNamespaceID);
-    this->info("   - Block: Object Individuals");
-    strOwl2 += this->generateObjectIndividuals(strNamespaceID);
-    this->info("   - Block: Human Individuals");
-    strOwl2 += this->generateHumanIndividuals(strNamespaceID);
-    this->info("   - Block: Image Individuals");
-    strOwl2 += this->generateImageIndividuals(strNamespaceID);
-    this->info("   - Block: Designator Individuals");
-    strOwl2 += this->generateDesignatorIndividuals(strNamespaceID);
-    this->info("   - Block: Failure Individuals");
-    strOwl2 += this->generateFailureIndividuals(strNamespaceID);
-    this->info("   - Block: Timepoint Individuals (this can take a while)");
-    strOwl2 += this->generateTimepointIndividuals(strNamespaceID);
-    this->info("   - Block: Meta Data Individual");
-    strOwl2 += this->generateMetaDataIndividual(strNamespaceID);
-    this->info("   - Block: Parameter Annotations");
-    strOwl2 += this->generateParameterAnnotationInformation(strNamespaceID);
-    strOwl2 += "</rdf:RDF>\n";
-    
-    // NOTE(winkler): Doing this afterwards, as the other blocks being
-    // placed after them in the file actually issue classes and
-    // properties that need to be mentioned in the definitions (which
-    // are placed further up in the file). That's why we're shifting
-    // order here.
+    this->generateOwlImports(strNamespace, osOwl);
     this->info("   - Block: Property Definitions");
-    strOwl += this->generatePropertyDefinitions();
+    this->generatePropertyDefinitions(ovIssued, osOwl);
     this->info("   - Block: Class Definitions");
-    strOwl += this->generateClassDefinitions();
+    this->generateClassDefinitions(ovIssued, osOwl);
+  }
+  
+  void CExporterOwl::generateOwlBlock(OwlBlock obBlock, std::string strNamespaceID, OutputSink* osOwl, OwlVocabulary* ovIssued) {
+    switch(obBlock) {
+    case OB_EVENTS:
+      this->info("   - Block: Event Individuals");
+      this->generateEventIndividuals(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_OBJECTS:
+      this->info("   - Block: Object Individuals");
+      this->generateObjectIndividuals(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_HUMANS:
+      this->info("   - Block: Human Individuals");
+      this->generateHumanIndividuals(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_IMAGES:
+      this->info("   - Block: Image Individuals");
+      this->generateImageIndividuals(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_DESIGNATORS:
+      this->info("   - Block: Designator Individuals");
+      this->generateDesignatorIndividuals(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_FAILURES:
+      this->info("   - Block: Failure Individuals");
+      this->generateFailureIndividuals(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_TIMEPOINTS:
+      this->info("   - Block: Timepoint Individuals (this can take a while)");
+      this->generateTimepointIndividuals(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_META_DATA:
+      this->info("   - Block: Meta Data Individual");
+      this->generateMetaDataIndividual(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    case OB_PARAMETER_ANNOTATIONS:
+      this->info("   - Block: Parameter Annotations");
+      this->generateParameterAnnotationInformation(strNamespaceID, *osOwl, *ovIssued);
+      break;
+      
+    default:
+      break;
+    }
+  }
+  
+  unsigned int CExporterOwl::exportThreads() {
+    int nThreads = (int)this->configuration()->floatValue("export-threads");
     
-    strOwl += strOwl2;
+    if(nThreads <= 0) {
+      nThreads = std::thread::hardware_concurrency();
+    }
+    
+    return (nThreads > 0 ? nThreads : 1);
+  }
+  
+  void CExporterOwl::generateOwlBlocks(const std::vector<OwlBlock>& vecBlocks, std::string strNamespaceID, const std::vector<OutputSink*>& vecBlockSinks, std::vector<OwlVocabulary>& vecVocabularies) {
+    unsigned int unThreads = std::min(this->exportThreads(), (unsigned int)vecBlocks.size());
+    
+    if(unThreads <= 1) {
+      for(OwlBlock obBlock : vecBlocks) {
+	this->generateOwlBlock(obBlock, strNamespaceID, vecBlockSinks[obBlock], &vecVocabularies[obBlock]);
+      }
+    } else {
+      WorkerPool wpBlocks(unThreads);
+      
+      for(OwlBlock obBlock : vecBlocks) {
+	wpBlocks.enqueue(std::bind(&CExporterOwl::generateOwlBlock, this, obBlock, strNamespaceID, vecBlockSinks[obBlock], &vecVocabularies[obBlock]));
+      }
+      
+      wpBlocks.shutdown();
+    }
+  }
+  
+  void CExporterOwl::generateOwlBody(std::string strNamespaceID, const std::vector<OutputSink*>& vecBlockSinks, OwlVocabulary& ovIssued) {
+    std::vector<OwlVocabulary> vecVocabularies(OB_COUNT);
+    
+    // Spooled individuals are neither generated nor defined again.
+    if(this->useSpool()) {
+      for(int nBlock = 0; nBlock < OB_COUNT; nBlock++) {
+	vecVocabularies[nBlock].merge(m_aovSpooled[nBlock]);
+      }
+    }
+    
+    // NOTE: Every block writes into its own sink and
+    // vocabulary. The event block collects the designators and
+    // annotated parameters that the designator, timepoint and
+    // parameter annotation blocks are built from, and the timepoint
+    // block widens the time range the meta data block reports. So
+    // blocks are generated in three waves; blocks within a wave
+    // share no mutable state.
+    std::vector<OwlBlock> vecIndependent = {OB_EVENTS, OB_OBJECTS, OB_HUMANS, OB_IMAGES, OB_FAILURES};
+    std::vector<OwlBlock> vecDesignatorDependent = {OB_DESIGNATORS, OB_TIMEPOINTS};
+    
+    this->generateOwlBlocks(vecIndependent, strNamespaceID, vecBlockSinks, vecVocabularies);
+    this->generateOwlBlocks(vecDesignatorDependent, strNamespaceID, vecBlockSinks, vecVocabularies);
+    
+    // Both draw unique IDs; keeping them sequential keeps the IDs stable.
+    this->generateOwlBlock(OB_META_DATA, strNamespaceID, vecBlockSinks[OB_META_DATA], &vecVocabularies[OB_META_DATA]);
+    this->generateOwlBlock(OB_PARAMETER_ANNOTATIONS, strNamespaceID, vecBlockSinks[OB_PARAMETER_ANNOTATIONS], &vecVocabularies[OB_PARAMETER_ANNOTATIONS]);
+    
+    for(const OwlVocabulary& ovBlock : vecVocabularies) {
+      ovIssued.merge(ovBlock);
+    }
     
     if(m_nThrowAndCatchFailureCounter > 0) {
       this->warn("Throw/Catch failure counter is > 0: '" + this->str(m_nThrowAndCatchFailureCounter) + "'");
     }
+  }
+  
+  bool CExporterOwl::writeOwlFile(std::string strFilename, std::string strNamespaceID, std::string strNamespace) {
+    // NOTE: The property and class definitions go before
+    // the individuals in the file, but are only known once all
+    // individuals were generated. So every block is streamed into a
+    // temporary file first, and they are spliced in after the
+    // definitions.
+    std::vector<std::string> vecBlockFilenames;
+    std::vector<BufferedFileWriter*> vecBlockWriters;
+    std::vector<OutputSink*> vecBlockSinks;
+    bool bSuccess = true;
+    
+    for(int nBlock = 0; nBlock < OB_COUNT; nBlock++) {
+      std::string strBlockFilename = strFilename + ".block" + this->str(nBlock) + ".tmp";
+      BufferedFileWriter* bfwBlock = new BufferedFileWriter();
+      
+      if(!bfwBlock->open(strBlockFilename)) {
+	this->fail("Unable to open temporary file '" + strBlockFilename + "' for writing.");
+	bSuccess = false;
+      }
+      
+      vecBlockFilenames.push_back(strBlockFilename);
+      vecBlockWriters.push_back(bfwBlock);
+      vecBlockSinks.push_back(bfwBlock);
+    }
+    
+    OwlVocabulary ovIssued;
+    
+    if(bSuccess) {
+      this->generateOwlBody(strNamespaceID, vecBlockSinks, ovIssued);
+      
+      for(BufferedFileWriter* bfwBlock : vecBlockWriters) {
+	bSuccess = bfwBlock->close() && bSuccess;
+      }
+    }
+    
+    if(bSuccess) {
+      this->info(" - Writing file");
+      BufferedFileWriter bfwOwl;
+      
+      if(bfwOwl.open(strFilename)) {
+	bfwOwl << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n\n";
+	this->generateOwlHead(strNamespace, ovIssued, bfwOwl);
+	
+	if(this->useSpool()) {
+	  bSuccess = m_bfwSpool->flush() && bfwOwl.appendFileContents(m_strSpoolFilename);
+	}
+	
+	for(const std::string& strBlockFilename : vecBlockFilenames) {
+	  bSuccess = bfwOwl.appendFileContents(strBlockFilename) && bSuccess;
+	}
+	
+	bfwOwl << "</rdf:RDF>\n";
+	bSuccess = bfwOwl.close() && bSuccess;
+      } else {
+	bSuccess = false;
+      }
+      
+      if(!bSuccess) {
+	this->fail("Failed to write OWL file '" + strFilename + "'.");
+      }
+    }
+    
+    for(unsigned int unBlock = 0; unBlock < vecBlockWriters.size(); unBlock++) {
+      delete vecBlockWriters[unBlock];
+      ::remove(vecBlockFilenames[unBlock].c_str());
+    }
+    
+    return bSuccess;
+  }
+  
+  std::string CExporterOwl::generateOwlStringForNodes(const std::vector<Node*>& vecNodes, std::string strNamespaceID, std::string strNamespace) {
+    std::vector<StringOutputSink> vecBlocks(OB_COUNT);
+    std::vector<OutputSink*> vecBlockSinks;
+    
+    for(StringOutputSink& sosBlock : vecBlocks) {
+      vecBlockSinks.push_back(&sosBlock);
+    }
+    
+    OwlVocabulary ovIssued;
+    this->generateOwlBody(strNamespaceID, vecBlockSinks, ovIssued);
+    
+    StringOutputSink sosOwl;
+    this->generateOwlHead(strNamespace, ovIssued, sosOwl);
+    
+    for(StringOutputSink& sosBlock : vecBlocks) {
+      sosOwl.write(sosBlock.content());
+    }
+    
+    sosOwl << "</rdf:RDF>\n";
+    
+    return sosOwl.content();
+  }
+  
+  std::string CExporterOwl::individualIDForNode(Node* ndNode) {
+    if(!m_bSpooling) {
+      return ndNode->uniqueID();
+    }
+    
+    m_mtxIndividualIDs.lock();
+    std::string& strID = m_mapIndividualIDs[ndNode];
+    
+    if(strID == "") {
+      strID = this->generateUniqueID(this->nodeIDPrefix(ndNode, "node_"));
+    }
+    
+    std::string strResult = strID;
+    m_mtxIndividualIDs.unlock();
+    
+    return strResult;
+  }
+  
+  void CExporterOwl::assignIndividualIDs(const std::vector<Node*>& vecNodes) {
+    for(Node* ndNode : vecNodes) {
+      if(ndNode && !this->nodeSpooled(ndNode)) {
+	this->individualIDForNode(ndNode);
+	this->assignIndividualIDs(ndNode->subnodes());
+      }
+    }
+  }
+  
+  bool CExporterOwl::nodeSpooled(Node* ndNode) {
+    return this->useSpool() && m_setSpooledNodes.find(ndNode) != m_setSpooledNodes.end();
+  }
+  
+  bool CExporterOwl::nodeAndAncestorsHaveValidDetailLevel(Node* ndNode) {
+    for(; ndNode; ndNode = ndNode->parent()) {
+      if(!this->nodeHasValidDetailLevel(ndNode)) {
+	return false;
+      }
+    }
+    
+    return true;
+  }
+  
+  bool CExporterOwl::startSpool(std::string strSpoolFilename) {
+    this->stopSpool();
+    
+    m_bfwSpool = new BufferedFileWriter();
+    
+    if(!m_bfwSpool->open(strSpoolFilename)) {
+      this->fail("Unable to open spool file '" + strSpoolFilename + "' for writing.");
+      
+      delete m_bfwSpool;
+      m_bfwSpool = NULL;
+      
+      return false;
+    }
+    
+    m_strSpoolFilename = strSpoolFilename;
+    m_bSpooling = true;
+    
+    return true;
+  }
+  
+  void CExporterOwl::stopSpool() {
+    if(m_bfwSpool) {
+      m_bfwSpool->close();
+      ::remove(m_strSpoolFilename.c_str());
+      
+      delete m_bfwSpool;
+      m_bfwSpool = NULL;
+    }
+    
+    for(OwlVocabulary& ovSpooled : m_aovSpooled) {
+      ovSpooled.clear();
+    }
+    
+    m_tsSpooled = {"", "", 0.0, 0.0, false};
+    m_setSpooledNodes.clear();
+    m_mapSpooledDesignators.clear();
+    m_lstSpooledAnnotatedParameters.clear();
+    m_nSpooledThrowAndCatchFailureCounter = 0;
+    m_mapIndividualIDs.clear();
+    
+    m_strSpoolFilename = "";
+    m_bSpooling = false;
+  }
+  
+  bool CExporterOwl::spooling() {
+    return m_bSpooling;
+  }
+  
+  void CExporterOwl::setIgnoreSpool(bool bIgnoreSpool) {
+    m_bIgnoreSpool = bIgnoreSpool;
+  }
+  
+  bool CExporterOwl::useSpool() {
+    return m_bSpooling && !m_bIgnoreSpool;
+  }
+  
+  void CExporterOwl::spoolClosedNode(Node* ndClosed) {
+    if(!m_bSpooling || !ndClosed) {
+      return;
+    }
+    
+    // ndClosed must be finalized: it and its whole subtree ended and
+    // the active context is not inside it, so none of these nodes
+    // change anymore. A node's individual refers to its previous
+    // and next sibling, so the sub-nodes of ndClosed are written
+    // now; ndClosed itself is written with its siblings, or at
+    // export time if it is a root node.
+    const std::vector<Node*>& vecSubnodes = ndClosed->subnodes();
+    
+    if(vecSubnodes.size() == 0) {
+      return;
+    }
+    
+    // The event generation collects into the working state; swap in
+    // the spooled one for the duration.
+    m_mapDesignators.swap(m_mapSpooledDesignators);
+    m_lstAnnotatedParameters.swap(m_lstSpooledAnnotatedParameters);
+    std::swap(m_nThrowAndCatchFailureCounter, m_nSpooledThrowAndCatchFailureCounter);
+    
+    // Batch exports skip the subtrees of nodes that are not
+    // displayed. The spool shows successes and failures alike, so
+    // only the detail level decides that, which does not depend on
+    // the (possibly still open) ancestors' success.
+    if(this->nodeAndAncestorsHaveValidDetailLevel(ndClosed)) {
+      this->generateEventIndividualsForNodes(vecSubnodes, m_strNamespaceID, *m_bfwSpool, m_aovSpooled[OB_EVENTS], false);
+    }
+    
+    m_mapDesignators.swap(m_mapSpooledDesignators);
+    m_lstAnnotatedParameters.swap(m_lstSpooledAnnotatedParameters);
+    std::swap(m_nThrowAndCatchFailureCounter, m_nSpooledThrowAndCatchFailureCounter);
+    
+    this->generateObjectIndividualsForNodes(vecSubnodes, m_strNamespaceID, *m_bfwSpool, m_aovSpooled[OB_OBJECTS], false);
+    this->generateHumanIndividualsForNodes(vecSubnodes, m_strNamespaceID, *m_bfwSpool, m_aovSpooled[OB_HUMANS], false);
+    this->generateImageIndividualsForNodes(vecSubnodes, m_strNamespaceID, *m_bfwSpool, m_aovSpooled[OB_IMAGES], false);
+    this->generateFailureIndividualsForNodes(vecSubnodes, m_strNamespaceID, *m_bfwSpool, m_aovSpooled[OB_FAILURES], false);
+    
+    std::vector<std::string> vecTimepoints;
+    this->gatherTimepointsForNodes(vecSubnodes, vecTimepoints, false);
+    this->generateTimepointIndividualsFor(vecTimepoints, m_tsSpooled, m_strNamespaceID, *m_bfwSpool, m_aovSpooled[OB_TIMEPOINTS]);
     
-    return strOwl;
+    m_setSpooledNodes.insert(vecSubnodes.begin(), vecSubnodes.end());
   }
 }
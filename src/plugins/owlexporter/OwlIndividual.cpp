@@ -41,26 +41,18 @@
 
 
 namespace semrec {
-  std::list<std::string> OwlIndividual::m_lstIssuedProperties;
-  std::list<std::string> OwlIndividual::m_lstIssuedTypes;
-  std::map<std::string, std::string> OwlIndividual::s_mapStaticResources;
-  std::map<std::string, std::string> OwlIndividual::s_mapStaticProperties;
-  
-  
   OwlIndividual::OwlIndividual() {
-    //
-  }
-  
-  OwlIndividual::~OwlIndividual() {
-    //
+    m_ovIssued = NULL;
+    m_ospStatic = NULL;
   }
   
-  void OwlIndividual::addStaticResource(std::string strKey, std::string strResource) {
-    s_mapStaticResources[strKey] = strResource;
+  OwlIndividual::OwlIndividual(OwlVocabulary& ovIssued, const OwlStaticProperties* ospStatic) {
+    m_ovIssued = &ovIssued;
+    m_ospStatic = ospStatic;
   }
   
-  void OwlIndividual::addStaticProperty(std::string strKey, std::string strProperty) {
-    s_mapStaticProperties[strKey] = strProperty;
+  OwlIndividual::~OwlIndividual() {
+    //
   }
   
   void OwlIndividual::setID(std::string strID) {
@@ -105,6 +97,10 @@ namespace semrec {
   }
   
   void OwlIndividual::issueProperty(std::string strProperty) {
+    if(!m_ovIssued) {
+      return;
+    }
+    
     std::string strPropertyFormatted = strProperty;
     
     size_t posColon = strPropertyFormatted.find(":");
@@ -113,14 +109,12 @@ namespace semrec {
       strPropertyFormatted = "&" + strPropertyFormatted.substr(0, posColon) + ";" + strPropertyFormatted.substr(posColon + 1);
     }
     
-    if(std::find(m_lstIssuedProperties.begin(), m_lstIssuedProperties.end(), strPropertyFormatted) == m_lstIssuedProperties.end()) {
-      m_lstIssuedProperties.push_back(strPropertyFormatted);
-    }
+    m_ovIssued->issueProperty(strPropertyFormatted);
   }
   
   void OwlIndividual::issueType(std::string strType) {
-    if(std::find(m_lstIssuedTypes.begin(), m_lstIssuedTypes.end(), strType) == m_lstIssuedTypes.end()) {
-      m_lstIssuedTypes.push_back(strType);
+    if(m_ovIssued) {
+      m_ovIssued->issueType(strType);
     }
   }
   
@@ -134,75 +128,69 @@ namespace semrec {
     return strIndentation;
   }
   
-  std::string OwlIndividual::print(int nIndentation, int nIndentationPerLevel) {
-    std::string strOwl = "";
+  void OwlIndividual::writeIndent(OutputSink& osOut, int nSpaces) {
+    static const std::string strSpaces(64, ' ');
     
-    if(strOwl != "") {
-      strOwl += this->indent(nIndentation * nIndentationPerLevel) + "\n";
+    while(nSpaces > 0) {
+      int nChunk = std::min(nSpaces, (int)strSpaces.length());
+      osOut.write(strSpaces.data(), nChunk);
+      nSpaces -= nChunk;
     }
+  }
+  
+  void OwlIndividual::print(OutputSink& osOut, int nIndentation, int nIndentationPerLevel) {
+    int nOuter = nIndentation * nIndentationPerLevel;
+    int nInner = (nIndentation + 1) * nIndentationPerLevel;
     
-    strOwl += this->indent(nIndentation * nIndentationPerLevel) +
-      "<owl:NamedIndividual rdf:about=\"" + m_strID + "\">\n";
+    this->writeIndent(osOut, nOuter);
+    osOut << "<owl:NamedIndividual rdf:about=\"" << m_strID << "\">\n";
     
     if(m_strType != "") {
-      strOwl += this->indent((nIndentation + 1) * nIndentationPerLevel) +
-	"<rdf:type rdf:resource=\"" + m_strType + "\"/>\n";
+      this->writeIndent(osOut, nInner);
+      osOut << "<rdf:type rdf:resource=\"" << m_strType << "\"/>\n";
     }
     
-    for(OwlProperty opProperty : m_lstProperties) {
-      strOwl += this->indent((nIndentation + 1) * nIndentationPerLevel);
-      strOwl += "<" + opProperty.strTag;
+    for(const OwlProperty& opProperty : m_lstProperties) {
+      this->writeIndent(osOut, nInner);
+      osOut << "<" << opProperty.strTag;
       
       if(opProperty.strDataType != "") {
-	strOwl += " rdf:datatype=\"" + opProperty.strDataType + "\">" + opProperty.strContent;
-	strOwl += "</" + opProperty.strTag + ">";
+	osOut << " rdf:datatype=\"" << opProperty.strDataType << "\">" << opProperty.strContent;
+	osOut << "</" << opProperty.strTag << ">";
       } else if(opProperty.strResource != "") {
-	strOwl += " rdf:resource=\"" + opProperty.strResource + "\"/>";
+	osOut << " rdf:resource=\"" << opProperty.strResource << "\"/>";
       } else {
-	strOwl += ">" + opProperty.strContent;
-	strOwl += "</" + opProperty.strTag + ">";
+	osOut << ">" << opProperty.strContent;
+	osOut << "</" << opProperty.strTag << ">";
       }
       
-      strOwl += "\n";
+      osOut << "\n";
     }
     
-    // Add static resources
-    for(std::pair<std::string, std::string> prResource : s_mapStaticResources) {
-      strOwl += this->indent((nIndentation + 1) * nIndentationPerLevel);
-      strOwl += "<knowrob:" + prResource.first + " rdf:resource=\"" + prResource.second + "\"/>";
-    }
-    
-    // Add static properties
-    for(std::pair<std::string, std::string> prProperty : s_mapStaticProperties) {
-      strOwl += this->indent((nIndentation + 1) * nIndentationPerLevel);
-      strOwl += "<knowrob:" + prProperty.first + " rdf:datatype=\"&xsd;string\">" + prProperty.second + "</knowrob:" + prProperty.first + ">\n";
+    if(m_ospStatic) {
+      // Add static resources
+      for(const std::pair<const std::string, std::string>& prResource : m_ospStatic->mapResources) {
+	this->writeIndent(osOut, nInner);
+	osOut << "<knowrob:" << prResource.first << " rdf:resource=\"" << prResource.second << "\"/>";
+      }
+      
+      // Add static properties
+      for(const std::pair<const std::string, std::string>& prProperty : m_ospStatic->mapProperties) {
+	this->writeIndent(osOut, nInner);
+	osOut << "<knowrob:" << prProperty.first << " rdf:datatype=\"&xsd;string\">" << prProperty.second << "</knowrob:" << prProperty.first << ">\n";
+      }
     }
     
-    strOwl += this->indent(nIndentation * nIndentationPerLevel) +
-      "</owl:NamedIndividual>\n";
-    strOwl += this->indent(nIndentation * nIndentationPerLevel) + "\n";
-    
-    return strOwl;
-  }
-  
-  void OwlIndividual::resetIssuedProperties() {
-    m_lstIssuedProperties.clear();
+    this->writeIndent(osOut, nOuter);
+    osOut << "</owl:NamedIndividual>\n";
+    this->writeIndent(osOut, nOuter);
+    osOut << "\n";
   }
   
-  void OwlIndividual::resetIssuedTypes() {
-    m_lstIssuedTypes.clear();
-  }
-  
-  void OwlIndividual::resetIssuedInformation() {
-    OwlIndividual::resetIssuedProperties();
-    OwlIndividual::resetIssuedTypes();
-  }
-  
-  std::list<std::string> OwlIndividual::issuedProperties() {
-    return m_lstIssuedProperties;
-  }
-  
-  std::list<std::string> OwlIndividual::issuedTypes() {
-    return m_lstIssuedTypes;
+  std::string OwlIndividual::print(int nIndentation, int nIndentationPerLevel) {
+    StringOutputSink sosOwl;
+    this->print(sosOwl, nIndentation, nIndentationPerLevel);
+    
+    return sosOwl.content();
   }
 }
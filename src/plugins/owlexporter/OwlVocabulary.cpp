@@ -0,0 +1,123 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Institute for Artificial Intelligence,
+ *  Universität Bremen.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Institute for Artificial Intelligence,
+ *     Universität Bremen, nor the names of its contributors may be
+ *     used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <semrec/plugins/owlexporter/OwlVocabulary.h>
+
+
+namespace semrec {
+  OwlVocabulary::OwlVocabulary() {
+  }
+  
+  OwlVocabulary::~OwlVocabulary() {
+  }
+  
+  bool OwlVocabulary::issue(std::string strEntry, std::vector<std::string>& vecEntries, std::unordered_set<std::string>& setEntries) {
+    if(setEntries.insert(strEntry).second) {
+      vecEntries.push_back(strEntry);
+      
+      return true;
+    }
+    
+    return false;
+  }
+  
+  bool OwlVocabulary::issueProperty(std::string strProperty) {
+    std::unique_lock<std::mutex> lckAccess(m_mtxAccess);
+    
+    return OwlVocabulary::issue(strProperty, m_vecIssuedProperties, m_setIssuedProperties);
+  }
+  
+  bool OwlVocabulary::issueType(std::string strType) {
+    std::unique_lock<std::mutex> lckAccess(m_mtxAccess);
+    
+    return OwlVocabulary::issue(strType, m_vecIssuedTypes, m_setIssuedTypes);
+  }
+  
+  bool OwlVocabulary::issueIndividual(std::string strID) {
+    std::unique_lock<std::mutex> lckAccess(m_mtxAccess);
+    
+    return m_setIssuedIndividuals.insert(strID).second;
+  }
+  
+  void OwlVocabulary::merge(const OwlVocabulary& ovOther) {
+    if(&ovOther == this) {
+      return;
+    }
+    
+    // Copied first, so the two locks are never held at once.
+    std::vector<std::string> vecProperties = ovOther.issuedProperties();
+    std::vector<std::string> vecTypes = ovOther.issuedTypes();
+    
+    ovOther.m_mtxAccess.lock();
+    std::unordered_set<std::string> setIndividuals = ovOther.m_setIssuedIndividuals;
+    ovOther.m_mtxAccess.unlock();
+    
+    std::unique_lock<std::mutex> lckAccess(m_mtxAccess);
+    
+    for(const std::string& strProperty : vecProperties) {
+      OwlVocabulary::issue(strProperty, m_vecIssuedProperties, m_setIssuedProperties);
+    }
+    
+    for(const std::string& strType : vecTypes) {
+      OwlVocabulary::issue(strType, m_vecIssuedTypes, m_setIssuedTypes);
+    }
+    
+    m_setIssuedIndividuals.insert(setIndividuals.begin(), setIndividuals.end());
+  }
+  
+  void OwlVocabulary::clear() {
+    std::unique_lock<std::mutex> lckAccess(m_mtxAccess);
+    
+    m_vecIssuedProperties.clear();
+    m_setIssuedProperties.clear();
+    m_vecIssuedTypes.clear();
+    m_setIssuedTypes.clear();
+    m_setIssuedIndividuals.clear();
+  }
+  
+  std::vector<std::string> OwlVocabulary::issuedProperties() const {
+    std::unique_lock<std::mutex> lckAccess(m_mtxAccess);
+    
+    return m_vecIssuedProperties;
+  }
+  
+  std::vector<std::string> OwlVocabulary::issuedTypes() const {
+    std::unique_lock<std::mutex> lckAccess(m_mtxAccess);
+    
+    return m_vecIssuedTypes;
+  }
+}
@@ -43,10 +43,16 @@
 namespace semrec {
   namespace plugins {
     PLUGIN_CLASS::PLUGIN_CLASS() {
+      m_bIncremental = false;
+      m_bIncrementalVerify = false;
+      m_nIncrementalMaxDetailLevel = 99;
+      m_expSpool = NULL;
+      
       this->setPluginVersion("0.93");
     }
     
     PLUGIN_CLASS::~PLUGIN_CLASS() {
+      this->discardSpool();
     }
     
     Result PLUGIN_CLASS::init(int argc, char** argv) {
@@ -61,10 +67,34 @@ namespace semrec {
       this->setSubscribedToEvent("update-absolute-experiment-end-time", true);
       this->setSubscribedToEvent("start-new-experiment", true);
       
+      Designator* cdConfig = this->getIndividualConfig();
+      m_bIncremental = (cdConfig->floatValue("incremental") != 0);
+      
+      if(cdConfig->childForKey("incremental-max-detail-level")) {
+	m_nIncrementalMaxDetailLevel = (int)cdConfig->floatValue("incremental-max-detail-level");
+      }
+      
+      m_bIncrementalVerify = (cdConfig->floatValue("incremental-verify") != 0);
+      
+      if(m_bIncremental) {
+	// Individuals of finalized contexts (ended, with all their
+	// sub-contexts, and not holding the active one) get spooled
+	// right away, failures and images with them, so exports only
+	// have to generate the part of the tree that is still open.
+	this->setSubscribedToEvent("symbolic-finalize-context", true);
+	this->info("Incremental OWL export enabled (max. detail level " + this->str(m_nIncrementalMaxDetailLevel) + ").");
+      } else {
+	// Exports work on plan tree snapshots then, so they don't have
+	// to hold up the core. The spool needs the live nodes, though.
+	this->setParallelDispatch(true);
+      }
+      
       return resInit;
     }
     
     Result PLUGIN_CLASS::deinit() {
+      this->discardSpool();
+      
       return defaultResult();
     }
     
@@ -75,8 +105,17 @@ namespace semrec {
       return resCycle;
     }
     
-    void PLUGIN_CLASS::consumeEvent(Event evEvent) {
-      if(evEvent.strEventName == "export-planlog") {
+    void PLUGIN_CLASS::consumeEvent(const Event& evEvent) {
+      if(evEvent.strEventName == "symbolic-finalize-context") {
+	// Finalize events deployed before a `start-new-experiment' can
+	// be dispatched after it; their nodes belong to the previous
+	// experiment, whose spool is gone.
+	bool bOutdated = (evEvent.ptdPlanTree && evEvent.ptdPlanTree->naNodes && evEvent.ptdPlanTree->naNodes->retired());
+	
+	if(evEvent.lstNodes.size() > 0 && !bOutdated) {
+	  this->spoolClosedNode(evEvent.lstNodes.front());
+	}
+      } else if(evEvent.strEventName == "export-planlog") {
 	if(evEvent.cdDesignator) {
 	  std::string strFormat = evEvent.cdDesignator->stringValue("format");
 	  transform(strFormat.begin(), strFormat.end(), strFormat.begin(), ::tolower);
@@ -88,7 +127,12 @@ namespace semrec {
 	    
 	    ServiceEvent seGetPlanTree = defaultServiceEvent("symbolic-plan-tree");
 	    seGetPlanTree.cdDesignator = new Designator(evEvent.cdDesignator);
-	    this->deployServiceEvent(seGetPlanTree);
+	    
+	    if(this->parallelDispatch() && configSnapshot()->bParallelDispatch) {
+	      seGetPlanTree.cdDesignator->setValue(std::string("snapshot"), 1);
+	    }
+	    
+	    this->requestService(seGetPlanTree, std::bind(&PLUGIN_CLASS::exportPlanTree, this, std::placeholders::_1));
 	  }
 	}
       } else if(evEvent.strEventName == "experiment-start") {
@@ -142,57 +186,118 @@ namespace semrec {
 	  }
 	}
       } else if(evEvent.strEventName == "update-absolute-experiment-start-time") {
-	if(evEvent.lstNodes.size() > 0) {
+	// The timestamp comes as a string, so the (live) node doesn't
+	// have to be read here.
+	if(evEvent.strSupplementary != "") {
 	  if(m_mapMetaData.find("time-start") == m_mapMetaData.end()) {
 	    // First entry
-	    m_mapMetaData["time-start"] = {MappedMetaData::Property, evEvent.lstNodes.front()->metaInformation()->stringValue("time-start")};
+	    m_mapMetaData["time-start"] = {MappedMetaData::Property, evEvent.strSupplementary};
 	  } else {
 	    // Update if necessary
 	    std::string strOld = m_mapMetaData["time-start"].strValue;
-	    std::string strNew = evEvent.lstNodes.front()->metaInformation()->stringValue("time-start");
 	    
-	    float fOld, fNew;
-	    sscanf(strOld.c_str(), "%f", &fOld);
-	    sscanf(strNew.c_str(), "%f", &fNew);
+	    double dOld, dNew;
+	    sscanf(strOld.c_str(), "%lf", &dOld);
+	    sscanf(evEvent.strSupplementary.c_str(), "%lf", &dNew);
 	    
-	    if(fNew < fOld) {
-	      m_mapMetaData["time-start"] = {MappedMetaData::Property, strNew};
+	    if(dNew < dOld) {
+	      m_mapMetaData["time-start"] = {MappedMetaData::Property, evEvent.strSupplementary};
 	    }
 	  }
 	}
       } else if(evEvent.strEventName == "update-absolute-experiment-end-time") {
-	if(evEvent.lstNodes.size() > 0) {
+	if(evEvent.strSupplementary != "") {
 	  // Every end time overwrites any already existing value, as
 	  // it always happens after.
 	  if(m_mapMetaData.find("time-end") == m_mapMetaData.end()) {
-	    m_mapMetaData["time-end"] = {MappedMetaData::Property, evEvent.lstNodes.front()->metaInformation()->stringValue("time-end")};
+	    m_mapMetaData["time-end"] = {MappedMetaData::Property, evEvent.strSupplementary};
 	  } else {
 	    // Update if necessary
 	    std::string strOld = m_mapMetaData["time-end"].strValue;
-	    std::string strNew = evEvent.lstNodes.front()->metaInformation()->stringValue("time-end");
 	    
 	    double dOld, dNew;
 	    sscanf(strOld.c_str(), "%lf", &dOld);
-	    sscanf(strNew.c_str(), "%lf", &dNew);
+	    sscanf(evEvent.strSupplementary.c_str(), "%lf", &dNew);
 	    
 	    if(dNew > dOld) {
-	      m_mapMetaData["time-end"] = {MappedMetaData::Property, strNew};
+	      m_mapMetaData["time-end"] = {MappedMetaData::Property, evEvent.strSupplementary};
 	    }
 	  }
 	}
       } else if(evEvent.strEventName == "start-new-experiment") {
 	m_mapMetaData.clear();
+	
+	// The nodes the spool refers to are gone.
+	this->discardSpool();
+      }
+    }
+    
+    CExporterOwl* PLUGIN_CLASS::createExporter(int nShowSuccesses, int nShowFails, int nMaxDetailLevel) {
+      CExporterOwl* expOwl = new CExporterOwl();
+      expOwl->setMetaData(m_mapMetaData);
+      
+      Designator* cdConfig = this->getIndividualConfig();
+      std::string strSemanticsDescriptorFile = cdConfig->stringValue("semantics-descriptor-file");
+      
+      if(strSemanticsDescriptorFile != "") {
+	this->info("Loading semantics descriptor file '" + strSemanticsDescriptorFile + "'");
+	
+	if(expOwl->loadSemanticsDescriptorFile(strSemanticsDescriptorFile) == false) {
+	  this->warn("Failed to load semantics descriptor file '" + strSemanticsDescriptorFile + "'.");
+	}
+      } else {
+	this->warn("No semantics descriptor file was specified.");
+      }
+      
+      expOwl->configuration()->setValue(std::string("display-successes"), nShowSuccesses);
+      expOwl->configuration()->setValue(std::string("display-failures"), nShowFails);
+      expOwl->configuration()->setValue(std::string("max-detail-level"), nMaxDetailLevel);
+      expOwl->configuration()->setValue(std::string("export-threads"), (int)cdConfig->floatValue("export-threads"));
+      
+      return expOwl;
+    }
+    
+    void PLUGIN_CLASS::spoolClosedNode(Node* ndClosed) {
+      m_mtxSpool.lock();
+      
+      if(!m_expSpool) {
+	// Spooled individuals are only valid for exports that show all
+	// nodes up to the configured detail level; the success of still
+	// open nodes is not known while spooling.
+	m_expSpool = this->createExporter(1, 1, m_nIncrementalMaxDetailLevel);
+	
+	std::string strSpoolFilename = configSnapshot()->strExperimentDirectory + "owl-individuals.spool";
+	
+	if(!m_expSpool->startSpool(strSpoolFilename)) {
+	  this->warn("Incremental OWL export not available, exports will be generated from scratch.");
+	}
+      }
+      
+      if(m_expSpool->spooling()) {
+	m_expSpool->spoolClosedNode(ndClosed);
       }
+      
+      m_mtxSpool.unlock();
     }
     
-    Event PLUGIN_CLASS::consumeServiceEvent(ServiceEvent seServiceEvent) {
-      Event evResult = defaultEvent();
+    void PLUGIN_CLASS::discardSpool() {
+      m_mtxSpool.lock();
+      
+      if(m_expSpool) {
+	delete m_expSpool;
+	m_expSpool = NULL;
+      }
       
+      m_mtxSpool.unlock();
+    }
+    
+    void PLUGIN_CLASS::exportPlanTree(const ServiceEvent& seServiceEvent) {
       if(seServiceEvent.siServiceIdentifier == SI_RESPONSE) {
 	if(seServiceEvent.strServiceName == "symbolic-plan-tree") {
 	  if(seServiceEvent.cdDesignator) {
-	    if(seServiceEvent.lstResultEvents.size() > 0) {
-	      Event evCar = seServiceEvent.lstResultEvents.front();
+	    if(seServiceEvent.lstResultEvents.size() > 0 && seServiceEvent.lstResultEvents.front().ptdPlanTree) {
+	      const Event& evCar = seServiceEvent.lstResultEvents.front();
+	      const PlanTreeData& ptdPlanTree = *evCar.ptdPlanTree;
 	      
 	      std::string strFormat = seServiceEvent.cdDesignator->stringValue("format");
 	      transform(strFormat.begin(), strFormat.end(), strFormat.begin(), ::tolower);
@@ -200,33 +305,33 @@ namespace semrec {
 	      if(strFormat == "owl") {
 		this->info("OWLExporter Plugin received plan log data. Exporting symbolic log.");
 		
-		CExporterOwl* expOwl = new CExporterOwl();
-		expOwl->setMetaData(m_mapMetaData);
+		int nShowSuccesses = (int)seServiceEvent.cdDesignator->floatValue("show-successes");
+		int nShowFails = (int)seServiceEvent.cdDesignator->floatValue("show-fails");
+		int nMaxDetailLevel = (int)seServiceEvent.cdDesignator->floatValue("max-detail-level");
 		
-		Designator* cdConfig = this->getIndividualConfig();
-		std::string strSemanticsDescriptorFile = cdConfig->stringValue("semantics-descriptor-file");
+		m_mtxSpool.lock();
 		
-		if(strSemanticsDescriptorFile != "") {
-		  this->info("Loading semantics descriptor file '" + strSemanticsDescriptorFile + "'");
-		  
-		  if(expOwl->loadSemanticsDescriptorFile(strSemanticsDescriptorFile) == false) {
-		    this->warn("Failed to load semantics descriptor file '" + strSemanticsDescriptorFile + "'.");
-		  }
+		CExporterOwl* expOwl = NULL;
+		bool bSpooled = (m_expSpool && m_expSpool->spooling());
+		
+		if(bSpooled && nShowSuccesses == 1 && nShowFails == 1 && nMaxDetailLevel == m_nIncrementalMaxDetailLevel) {
+		  this->info("Using spooled individuals, generating open contexts only.");
+		  expOwl = m_expSpool;
 		} else {
-		  this->warn("No semantics descriptor file was specified.");
+		  if(bSpooled) {
+		    this->info("Requested display settings differ from the spooled ones, exporting from scratch.");
+		    bSpooled = false;
+		  }
+		  
+		  expOwl = this->createExporter(nShowSuccesses, nShowFails, nMaxDetailLevel);
 		}
 		
-		expOwl->configuration()->setValue(std::string("display-successes"), (int)seServiceEvent.cdDesignator->floatValue("show-successes"));
-		expOwl->configuration()->setValue(std::string("display-failures"), (int)seServiceEvent.cdDesignator->floatValue("show-fails"));
-		expOwl->configuration()->setValue(std::string("max-detail-level"), (int)seServiceEvent.cdDesignator->floatValue("max-detail-level"));
-		
-		expOwl->setRootNodes(evCar.lstRootNodes);
+		expOwl->setRootNodes(ptdPlanTree.lstRootNodes);
+		expOwl->setNodes(evCar.lstNodes);
 		
 		bool bFailed = false;
 		for(Node* ndNode : evCar.lstNodes) {
-		  if(ndNode) {
-		    expOwl->addNode(ndNode);
-		  } else {
+		  if(!ndNode) {
 		    this->fail("One of the nodes received in the plan log data contains invalid data. Cancelling export. Try again at will.");
 		    bFailed = true;
 		    break;
@@ -236,12 +341,9 @@ namespace semrec {
 		if(!bFailed) {
 		  this->info("Parameterizing exporter");
 		  
-		  expOwl->setDesignatorIDs(evCar.lstDesignatorIDs);
-		  expOwl->setDesignatorEquations(evCar.lstEquations);
-		  expOwl->setDesignatorEquationTimes(evCar.lstEquationTimes);
+		  expOwl->setDesignatorRegistry(ptdPlanTree.drDesignators);
 		  
-		  ConfigSettings cfgsetCurrent = configSettings();
-		  expOwl->setOutputFilename(cfgsetCurrent.strExperimentDirectory + seServiceEvent.cdDesignator->stringValue("filename"));
+		  expOwl->setOutputFilename(configSnapshot()->strExperimentDirectory + seServiceEvent.cdDesignator->stringValue("filename"));
 		  expOwl->setRegisteredOWLNamespaces(m_mapRegisteredOWLNamespaces);
 		  
 		  double dEarliest = -1;
@@ -249,33 +351,21 @@ namespace semrec {
 		  double dLatest = -1;
 		  std::string strLatest = "";
 		  
-		  for(Node* ndRoot : evCar.lstRootNodes) {
+		  for(Node* ndRoot : ptdPlanTree.lstRootNodes) {
 		    if(strEarliest == "") {
-		      strEarliest = ndRoot->metaInformation()->stringValue("time-start");
-		      sscanf(strEarliest.c_str(), "%lf", &dEarliest);
-		    } else {
-		      std::string strEarliestTemp = ndRoot->metaInformation()->stringValue("time-start");
-		      double dEarliestTemp;
-		      sscanf(strEarliestTemp.c_str(), "%lf", &dEarliestTemp);
-		      
-		      if(dEarliestTemp < dEarliest) {
-			strEarliest = strEarliestTemp;
-			dEarliest = dEarliestTemp;
-		      }
+		      strEarliest = ndRoot->timeStartString();
+		      dEarliest = ndRoot->timeStart();
+		    } else if(ndRoot->timeStart() < dEarliest) {
+		      strEarliest = ndRoot->timeStartString();
+		      dEarliest = ndRoot->timeStart();
 		    }
 		    
 		    if(strLatest == "") {
-		      strLatest = ndRoot->metaInformation()->stringValue("time-end");
-		      sscanf(strLatest.c_str(), "%lf", &dLatest);
-		    } else {
-		      std::string strLatestTemp = ndRoot->metaInformation()->stringValue("time-end");
-		      double dLatestTemp;
-		      sscanf(strLatestTemp.c_str(), "%lf", &dLatestTemp);
-		      
-		      if(dLatestTemp < dLatest) {
-			strLatest = strLatestTemp;
-			dLatest = dLatestTemp;
-		      }
+		      strLatest = ndRoot->timeEndString();
+		      dLatest = ndRoot->timeEnd();
+		    } else if(ndRoot->timeEnd() < dLatest) {
+		      strLatest = ndRoot->timeEndString();
+		      dLatest = ndRoot->timeEnd();
 		    }
 		  }
 		  
@@ -295,6 +385,21 @@ namespace semrec {
 		  
 		  if(expOwl->runExporter(NULL)) {
 		    this->info("Successfully exported OWL file '" + expOwl->outputFilename() + "'", true);
+		    
+		    if(bSpooled && m_bIncrementalVerify) {
+		      // Export the same tree without the spool, for
+		      // comparison with scripts/owl-incremental-check.py
+		      expOwl->setIgnoreSpool(true);
+		      expOwl->setOutputFilename(expOwl->outputFilename() + ".batch");
+		      
+		      if(expOwl->runExporter(NULL)) {
+			this->info("Exported OWL file '" + expOwl->outputFilename() + "' for verification", true);
+		      } else {
+			this->warn("Failed to export OWL file '" + expOwl->outputFilename() + "' for verification", true);
+		      }
+		      
+		      expOwl->setIgnoreSpool(false);
+		    }
 		  } else {
 		    this->warn("Failed to export to OWL file '" + expOwl->outputFilename() + "'", true);
 		  }
@@ -302,14 +407,16 @@ namespace semrec {
 		  this->warn("Failed to export to OWL file '" + expOwl->outputFilename() + "'", true);
 		}
 		
-		delete expOwl;
+		if(!bSpooled) {
+		  delete expOwl;
+		}
+		
+		m_mtxSpool.unlock();
 	      }
 	    }
 	  }
 	}
       }
-      
-      return evResult;
     }
   }
   
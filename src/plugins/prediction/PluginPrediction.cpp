@@ -103,7 +103,7 @@ namespace semrec {
       return resCycle;
     }
     
-    Event PLUGIN_CLASS::consumeServiceEvent(ServiceEvent seEvent) {
+    Event PLUGIN_CLASS::consumeServiceEvent(const ServiceEvent& seEvent) {
       Event evReturn = this->Plugin::consumeServiceEvent(seEvent);
       
       if(seEvent.siServiceIdentifier == SI_REQUEST) {
@@ -211,7 +211,7 @@ namespace semrec {
       return evReturn;
     }
     
-    void PLUGIN_CLASS::consumeEvent(Event evEvent) {
+    void PLUGIN_CLASS::consumeEvent(const Event& evEvent) {
       if(evEvent.strEventName == "symbolic-begin-context") {
 	if(m_bInsidePredictionModel) {
 	  if(evEvent.lstNodes.size() > 0) {
@@ -631,17 +631,12 @@ namespace semrec {
 	// Find TAGNAME if this is a tag
 	std::string strTagName = "";
 	
-	KeyValuePair* ckvpDesignators = m_ndActive->metaInformation()->childForKey("designators");
-	if(ckvpDesignators) {
-	  for(KeyValuePair* ckvpDesignator : ckvpDesignators->children()) {
-	    KeyValuePair* ckvpDescription = ckvpDesignator->childForKey("description");
+	for(const NodeDesignator& ndgDesignator : m_ndActive->designators()) {
+	  if(ndgDesignator.ckvpDescription) {
+	    strTagName = ndgDesignator.ckvpDescription->stringValue("tagname");
 	    
-	    if(ckvpDescription) {
-	      strTagName = ckvpDescription->stringValue("tagname");
-	      
-	      if(strTagName != "") {
-		break;
-	      }
+	    if(strTagName != "") {
+	      break;
 	    }
 	  }
 	}
@@ -55,6 +55,7 @@ namespace semrec {
     }
     
     PLUGIN_CLASS::~PLUGIN_CLASS() {
+      messageSink().removeConsumer(this);
       this->shutdownSpinWorker();
       
       if(m_nhHandle) {
@@ -76,10 +77,6 @@ namespace semrec {
       this->setSubscribedToEvent("symbolic-add-image", true);
       this->setSubscribedToEvent("cancel-open-request", true);
       
-      if(cdConfig->floatValue("roslog-messages") != 0) {
-	this->setSubscribedToEvent("status-message", false);
-      }
-      
       if(!ros::ok()) {
 	std::string strROSNodeName = cdConfig->stringValue("node-name");
 	
@@ -102,8 +99,12 @@ namespace semrec {
 	    std::string strTopic = cdConfig->stringValue("roslog-topic");
 	    
 	    if(strTopic != "") {
-	      m_pubStatusMessages = m_nhHandle->advertise<rosgraph_msgs::Log>(strTopic, 1);
+	      // Messages arrive in batches, so the publisher has to be
+	      // able to queue more than one of them.
+	      m_pubStatusMessages = m_nhHandle->advertise<rosgraph_msgs::Log>(strTopic, 100);
 	      m_bRoslogMessages = true;
+	      
+	      messageSink().addConsumer(this);
 	    } else {
 	      this->warn("You requested the status messages to be roslog'ged, but didn't specify a roslog topic. Ignoring the whole thing.");
 	    }
@@ -123,6 +124,7 @@ namespace semrec {
     }
     
     Result PLUGIN_CLASS::deinit() {
+      messageSink().removeConsumer(this);
       ros::shutdown();
       
       return defaultResult();
@@ -201,15 +203,14 @@ namespace semrec {
       
       transform(strCBType.begin(), strCBType.end(), strCBType.begin(), ::tolower);
       
+      // Matched by name, as the callback type comes from the outside
+      // (see the alter commands below).
       if(strCBType == "begin") {
 	Event evBeginContext = defaultEvent("begin-context");
 	evBeginContext.nContextID = createContextID();
 	evBeginContext.cdDesignator = new Designator(req.request.designator);
 	
-	std::stringstream sts;
-	sts << evBeginContext.nContextID;
-	
-	this->info("Beginning context (ID = " + sts.str() + "): '" + evBeginContext.cdDesignator->stringValue("_name") + "'");
+	SEMREC_INFO("Beginning context (ID = " + this->str(evBeginContext.nContextID) + "): '" + evBeginContext.cdDesignator->stringValue("_name") + "'");
 	this->deployEvent(evBeginContext);
 	
 	Designator *desigResponse = new Designator();
@@ -228,10 +229,8 @@ namespace semrec {
 	evEndContext.cdDesignator = new Designator(req.request.designator);
 	
 	int nContextID = (int)evEndContext.cdDesignator->floatValue("_id");
-	std::stringstream sts;
-	sts << nContextID;
 	
-	this->info("When ending context (ID = " + sts.str() + "), received " + this->getDesignatorTypeString(evEndContext.cdDesignator) + " designator");
+	SEMREC_INFO("When ending context (ID = " + this->str(nContextID) + "), received " + this->getDesignatorTypeString(evEndContext.cdDesignator) + " designator");
 	this->deployEvent(evEndContext);
 	
 	freeContextID(nContextID);
@@ -264,44 +263,42 @@ namespace semrec {
 	  
 	  delete seService.cdDesignator;
 	} else if(evAlterContext.cdDesignator->stringValue("_type") == "alter") {
-	  this->info("When altering context, received " + this->getDesignatorTypeString(evAlterContext.cdDesignator) + " designator");
+	  SEMREC_INFO("When altering context, received " + this->getDesignatorTypeString(evAlterContext.cdDesignator) + " designator");
 	  
 	  std::string strCommand = evAlterContext.cdDesignator->stringValue("command");
 	  transform(strCommand.begin(), strCommand.end(), strCommand.begin(), ::tolower);
 	  
-	  if(strCommand == "add-image") {
-	    evAlterContext.strEventName = "add-image-from-topic";
-	    evAlterContext.nOpenRequestID = this->openNewRequestID();
-	  } else if(strCommand == "add-failure") {
-	    evAlterContext.strEventName = "add-failure";
-	  } else if(strCommand == "add-designator") {
-	    evAlterContext.strEventName = "add-designator";
-	  } else if(strCommand == "equate-designators") {
-	    evAlterContext.strEventName = "equate-designators";
-	  } else if(strCommand == "add-object") {
-	    evAlterContext.strEventName = "add-object";
-	  } else if(strCommand == "add-human") {
-	    evAlterContext.strEventName = "add-human";
-	  } else if(strCommand == "export-planlog") {
-	    evAlterContext.strEventName = "export-planlog";
-	  } else if(strCommand == "start-new-experiment") {
-	    evAlterContext.strEventName = "start-new-experiment";
-	  } else if(strCommand == "set-experiment-meta-data") {
-	    evAlterContext.strEventName = "set-experiment-meta-data";
-	  } else if(strCommand == "register-interactive-object") {
-	    evAlterContext.strEventName = "symbolic-add-object";
-	  } else if(strCommand == "unregister-interactive-object") {
-	    evAlterContext.strEventName = "symbolic-remove-object";
-	  } else if(strCommand == "set-interactive-object-menu") {
-	    evAlterContext.strEventName = "symbolic-set-interactive-object-menu";
-	  } else if(strCommand == "update-interactive-object-pose") {
-	    evAlterContext.strEventName = "symbolic-update-object-pose";
-	  } else if(strCommand == "catch-failure") {
-	    evAlterContext.strEventName = "catch-failure";
-	  } else if(strCommand == "rethrow-failure") {
-	    evAlterContext.strEventName = "rethrow-failure";
+	  // Commands are arbitrary strings from the outside, so they are
+	  // matched by name rather than by identifier (an unknown
+	  // command sharing its identifier with a known one must still
+	  // be forwarded as is).
+	  static const std::unordered_map<std::string, std::string> mapAlterCommandEvents = {
+	    {"add-image", "add-image-from-topic"},
+	    {"add-failure", "add-failure"},
+	    {"add-designator", "add-designator"},
+	    {"equate-designators", "equate-designators"},
+	    {"add-object", "add-object"},
+	    {"add-human", "add-human"},
+	    {"export-planlog", "export-planlog"},
+	    {"start-new-experiment", "start-new-experiment"},
+	    {"set-experiment-meta-data", "set-experiment-meta-data"},
+	    {"register-interactive-object", "symbolic-add-object"},
+	    {"unregister-interactive-object", "symbolic-remove-object"},
+	    {"set-interactive-object-menu", "symbolic-set-interactive-object-menu"},
+	    {"update-interactive-object-pose", "symbolic-update-object-pose"},
+	    {"catch-failure", "catch-failure"},
+	    {"rethrow-failure", "rethrow-failure"}};
+	  
+	  std::unordered_map<std::string, std::string>::const_iterator itEvent = mapAlterCommandEvents.find(strCommand);
+	  
+	  if(itEvent != mapAlterCommandEvents.end()) {
+	    evAlterContext.strEventName = itEvent->second;
+	    
+	    if(strCommand == "add-image") {
+	      evAlterContext.nOpenRequestID = this->openNewRequestID();
+	    }
 	  } else {
-	    this->info("Forwarding alter command: '" + strCommand + "'");
+	    SEMREC_INFO("Forwarding alter command: '" + strCommand + "'");
 	    evAlterContext.strEventName = strCommand;
 	  }
 	  
@@ -318,43 +315,54 @@ namespace semrec {
       return bReturn;
     }
     
-    void PLUGIN_CLASS::consumeEvent(Event evEvent) {
+    void PLUGIN_CLASS::consumeEvent(const Event& evEvent) {
       if(evEvent.bRequest == false) {
 	this->closeRequestID(evEvent.nOpenRequestID);
       } else {
-	if(evEvent.strEventName == "symbolic-add-image") {
-	  this->closeRequestID(evEvent.nOpenRequestID);
-	} else if(evEvent.strEventName == "cancel-open-request") {
+	switch(evEvent.eiEventID) {
+	case eventID("symbolic-add-image"):
+	case eventID("cancel-open-request"): {
 	  this->closeRequestID(evEvent.nOpenRequestID);
-	} else if(evEvent.strEventName == "symbolic-create-designator") {
+	} break;
+	  
+	case eventID("symbolic-create-designator"): {
 	  if(evEvent.cdDesignator) {
 	    m_pubLoggedDesignators.publish(evEvent.cdDesignator->serializeToMessage());
 	  }
-	} else if(evEvent.strEventName == "interactive-callback") {
+	} break;
+	  
+	case eventID("interactive-callback"): {
 	  if(evEvent.cdDesignator) {
 	    m_pubInteractiveCallback.publish(evEvent.cdDesignator->serializeToMessage());
 	  }
-	} else if(evEvent.strEventName == "status-message") {
-	  if(m_bRoslogMessages) {
-	    StatusMessage msgStatus = evEvent.msgStatusMessage;
-	    rosgraph_msgs::Log rgmLogMessage;
-	    
-	    if(msgStatus.bBold == true) {
-	      rgmLogMessage.level = rosgraph_msgs::Log::WARN;
-	    } else {
-	      rgmLogMessage.level = rosgraph_msgs::Log::INFO;
-	    }
-	    
-	    rgmLogMessage.name = msgStatus.strPrefix;
-	    rgmLogMessage.msg = msgStatus.strMessage;
-	    
-	    m_pubStatusMessages.publish(rgmLogMessage);
+	} break;
+	  
+	default:
+	  break;
+	}
+      }
+    }
+    
+    void PLUGIN_CLASS::consumeStatusMessages(const std::vector<StatusMessage>& vecMessages) {
+      if(m_bRoslogMessages) {
+	for(const StatusMessage& msgStatus : vecMessages) {
+	  rosgraph_msgs::Log rgmLogMessage;
+	  
+	  if(msgStatus.bBold == true) {
+	    rgmLogMessage.level = rosgraph_msgs::Log::WARN;
+	  } else {
+	    rgmLogMessage.level = rosgraph_msgs::Log::INFO;
 	  }
+	  
+	  rgmLogMessage.name = msgStatus.strPrefix;
+	  rgmLogMessage.msg = msgStatus.strMessage;
+	  
+	  m_pubStatusMessages.publish(rgmLogMessage);
 	}
       }
     }
     
-    Event PLUGIN_CLASS::consumeServiceEvent(ServiceEvent seServiceEvent) {
+    Event PLUGIN_CLASS::consumeServiceEvent(const ServiceEvent& seServiceEvent) {
       Event evReturn = Plugin::consumeServiceEvent(seServiceEvent);
       
       //this->info("Consume service event of type '" + seServiceEvent.strServiceName + "'!");
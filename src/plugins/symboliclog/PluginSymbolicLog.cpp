@@ -48,18 +48,15 @@ namespace semrec {
       
       m_prLastFailure = std::make_pair("", (Node*)NULL);
       
-      // Random seed
-      srand(time(NULL));
-      
       m_ndActive = NULL;
+      
+      this->renewNodeArena();
     }
     
     PLUGIN_CLASS::~PLUGIN_CLASS() {
-      for(Node* ndNode : m_lstNodes) {
-	delete ndNode;
-      }
-      
       m_lstNodes.clear();
+      m_lstNodesWithoutTimeEnd.clear();
+      m_naNodes->retire();
     }
     
     Result PLUGIN_CLASS::init(int argc, char** argv) {
@@ -86,6 +83,7 @@ namespace semrec {
       this->setOffersService("symbolic-plan-tree", true);
       this->setOffersService("symbolic-plan-context", true);
       this->setOffersService("resolve-designator-memory-address", true);
+      this->setOffersService("equivalent-designators", true);
       
       Designator* cdConfig = this->getIndividualConfig();
       std::string strSemanticsDescriptorFile = cdConfig->stringValue("semantics-descriptor-file");
@@ -106,7 +104,7 @@ namespace semrec {
       return resCycle;
     }
     
-    Event PLUGIN_CLASS::consumeServiceEvent(ServiceEvent seServiceEvent) {
+    Event PLUGIN_CLASS::consumeServiceEvent(const ServiceEvent& seServiceEvent) {
       Event evReturn = this->Plugin::consumeServiceEvent(seServiceEvent);
       
       if(seServiceEvent.siServiceIdentifier == SI_REQUEST) {
@@ -122,32 +120,85 @@ namespace semrec {
 	  
 	  seResponse.cdDesignator = cdResponse;
 	  this->deployServiceEvent(seResponse);
+	} else if(seServiceEvent.strServiceName == "equivalent-designators") {
+	  // All designators equated to the given one (by ID or memory
+	  // address), directly or via chains of equations
+	  ServiceEvent seResponse = eventInResponseTo(seServiceEvent);
+	  Designator* cdRequest = seServiceEvent.cdDesignator;
+	  
+	  if(cdRequest) {
+	    std::string strID = cdRequest->stringValue("id");
+	    if(strID == "") {
+	      strID = this->getDesignatorID(cdRequest->stringValue("memory-address"));
+	    }
+	    
+	    seResponse.bPreserve = true;
+	    Designator* cdResponse = new Designator();
+	    cdResponse->setType(Designator::DesignatorType::ACTION);
+	    cdResponse->setValue("id", strID);
+	    
+	    KeyValuePair* ckvpEquivalents = cdResponse->addChild("equivalent-ids");
+	    unsigned int unIndex = 0;
+	    for(std::string strEquivalentID : m_drDesignators.equivalentIDs(strID)) {
+	      ckvpEquivalents->setValue("id-" + this->str((int)unIndex++), strEquivalentID);
+	    }
+	    
+	    seResponse.cdDesignator = cdResponse;
+	  } else {
+	    this->warn("No designator given to look up equivalent designators for.");
+	  }
+	  
+	  // Without a designator to look up, the response is empty (but
+	  // still sent, so that waiting requesters return).
+	  this->deployServiceEvent(seResponse);
 	} else if(seServiceEvent.strServiceName == "symbolic-plan-tree") {
 	  // Requested the whole symbolic plan log
-	  evReturn.lstNodes = m_lstNodes;
-	  evReturn.lstRootNodes = m_lstRootNodes;
+	  std::shared_ptr<PlanTreeData> ptdPlanTree = std::make_shared<PlanTreeData>();
 	  
-	  evReturn.lstDesignatorIDs = m_lstDesignatorIDs;
-	  evReturn.lstEquations = m_lstDesignatorEquations;
-	  evReturn.lstEquationTimes = m_lstDesignatorEquationTimes;
+	  if(seServiceEvent.cdDesignator && seServiceEvent.cdDesignator->floatValue("snapshot") != 0) {
+	    // The requester reads the tree off the core thread, so it
+	    // gets a copy that doesn't change while it does.
+	    std::unordered_map<Node*, Node*> mapCopies;
+	    
+	    ptdPlanTree->naNodes = std::make_shared<NodeArena>();
+	    ptdPlanTree->lstRootNodes = ptdPlanTree->naNodes->copyTrees(m_lstRootNodes, mapCopies);
+	    
+	    for(Node* ndNode : m_lstNodes) {
+	      std::unordered_map<Node*, Node*>::iterator itCopy = mapCopies.find(ndNode);
+	      
+	      if(itCopy != mapCopies.end()) {
+		evReturn.lstNodes.push_back(itCopy->second);
+	      }
+	    }
+	  } else {
+	    evReturn.lstNodes = m_lstNodes;
+	    ptdPlanTree->lstRootNodes = m_lstRootNodes;
+	  }
+	  
+	  ptdPlanTree->drDesignators = std::make_shared<DesignatorRegistry>(m_drDesignators);
+	  evReturn.ptdPlanTree = ptdPlanTree;
 	} else if(seServiceEvent.strServiceName == "symbolic-plan-context") {
 	  // Requested the current path in the symbolic plan log
 	  Node* ndCurrent = this->activeNode();
 	  
 	  while(ndCurrent) {
 	    evReturn.lstNodes.push_back(ndCurrent);
-	    evReturn.lstRootNodes = m_lstRootNodes;
 	    
 	    ndCurrent = ndCurrent->parent();
 	  }
+	  
+	  std::shared_ptr<PlanTreeData> ptdPlanTree = std::make_shared<PlanTreeData>();
+	  ptdPlanTree->lstRootNodes = m_lstRootNodes;
+	  evReturn.ptdPlanTree = ptdPlanTree;
 	}
       }
       
       return evReturn;
     }
     
-    void PLUGIN_CLASS::consumeEvent(Event evEvent) {
-      if(evEvent.strEventName == "begin-context") {
+    void PLUGIN_CLASS::consumeEvent(const Event& evEvent) {
+      switch(evEvent.eiEventID) {
+      case eventID("begin-context"): {
 	std::string strName = evEvent.cdDesignator->stringValue("_name");
 
 	Node* ndFormerParent = this->relativeActiveNode(evEvent);
@@ -157,46 +208,43 @@ namespace semrec {
 	// This means we're setting an implicit success for this node.
 	this->setNodeSuccess(ndNew, true);
 	
-	std::string strTimeStart = this->getTimeStampStr();
+	double dTimeStart = this->getTimeStampPrecise();
 	if(evEvent.cdDesignator->childForKey("_time-start")) {
-	  strTimeStart = this->getTimeStampStr(evEvent.cdDesignator->floatValue("_time-start"));
+	  dTimeStart = evEvent.cdDesignator->floatValue("_time-start");
 	}
 	
-	ndNew->metaInformation()->setValue(std::string("time-start"), strTimeStart);
+	ndNew->setTimeStart(dTimeStart, this->getTimeStampStr(dTimeStart));
 	
 	if(evEvent.cdDesignator->childForKey("_class")) {
-	  ndNew->metaInformation()->setValue(std::string("class"), evEvent.cdDesignator->stringValue("_class"));
-	  
-	  if(evEvent.cdDesignator->childForKey("_classnamespace")) {
-	    ndNew->metaInformation()->setValue(std::string("classnamespace"), evEvent.cdDesignator->stringValue("_classnamespace"));
-	  }
+	  ndNew->setClass(evEvent.cdDesignator->stringValue("_class"), evEvent.cdDesignator->stringValue("_classnamespace"));
 	}
 	
 	int nDetailLevel = (int)evEvent.cdDesignator->floatValue("_detail-level");
-	ndNew->metaInformation()->setValue(std::string("detail-level"), nDetailLevel);
+	ndNew->setDetailLevel(nDetailLevel);
 	
 	Event evUpdateExperimentTime = defaultEvent("update-absolute-experiment-start-time");
 	evUpdateExperimentTime.lstNodes.push_back(ndNew);
-	this->deployEvent(evUpdateExperimentTime);
+	evUpdateExperimentTime.strSupplementary = ndNew->timeStartString();
+	this->deployEvent(std::move(evUpdateExperimentTime));
 	
 	Event evSymbolicBeginCtx = defaultEvent("symbolic-begin-context");
 	evSymbolicBeginCtx.lstNodes.push_back(ndNew);
-	this->deployEvent(evSymbolicBeginCtx);
+	this->deployEvent(std::move(evSymbolicBeginCtx));
 	
 	Event evSymbolicSetSubcontext = defaultEvent("symbolic-set-subcontext");
 	evSymbolicSetSubcontext.lstNodes.push_back(ndFormerParent);
 	evSymbolicSetSubcontext.lstNodes.push_back(ndNew);
-	this->deployEvent(evSymbolicSetSubcontext);
-      } else if(evEvent.strEventName == "end-context") {
+	this->deployEvent(std::move(evSymbolicSetSubcontext));
+      } break;
+	
+      case eventID("end-context"): {
 	int nID = (int)evEvent.cdDesignator->floatValue("_id");
 	int nSuccess = (int)evEvent.cdDesignator->floatValue("_success");
 	Node* ndCurrent = this->relativeActiveNode(evEvent);
         
 	if(ndCurrent) {
 	  if(ndCurrent->id() == nID) {
-	    std::stringstream sts;
-	    sts << "Received stop context designator for ID " << nID << " (success: " << (nSuccess ? "yes" : "no") << ")";
-	    this->info(sts.str());
+	    SEMREC_INFO("Received stop context designator for ID " + this->str(nID) + " (success: " + (nSuccess ? "yes" : "no") + ")");
             
 	    // Set success only if no failures are present (in
 	    // which case the success is set to 'false' already)
@@ -212,11 +260,13 @@ namespace semrec {
 	      this->setNodeSuccess(ndCurrent, false);
 	    }
 	    
-	    std::string strTimeEnd = this->getTimeStampStr();
+	    double dTimeEnd = this->getTimeStampPrecise();
 	    if(evEvent.cdDesignator->childForKey("_time-end")) {
-	      strTimeEnd = this->getTimeStampStr(evEvent.cdDesignator->floatValue("_time-end"));
+	      dTimeEnd = evEvent.cdDesignator->floatValue("_time-end");
 	    }
-	    ndCurrent->metaInformation()->setValue(std::string("time-end"), strTimeEnd);
+	    
+	    std::string strTimeEnd = this->getTimeStampStr(dTimeEnd);
+	    ndCurrent->setTimeEnd(dTimeEnd, strTimeEnd);
 
 	    Node* ndParent = ndCurrent->parent();
 	    Node* ndParentLastValid = NULL;
@@ -226,13 +276,11 @@ namespace semrec {
 	      ndParentLastValid = ndParent;
 	      
 	      if(ndParent->prematurelyEnded()) {
-		std::stringstream sts_id;
-		sts_id << ndParent->id();
-		this->info("Node ID " + sts_id.str() + " ended prematurely, removing from context stack.");
+		SEMREC_INFO("Node ID " + this->str(ndParent->id()) + " ended prematurely, removing from context stack.");
 		
 		// Setting the same values for success and end time as
 		// for the actually ended node.
-		ndParent->metaInformation()->setValue(std::string("time-end"), strTimeEnd);
+		ndParent->setTimeEnd(dTimeEnd, strTimeEnd);
 		
 		// Set success only if no failures are present (in
 		// which case the success is set to 'false' already)
@@ -244,7 +292,8 @@ namespace semrec {
 		
 		Event evSymbolicEndCtx = defaultEvent("symbolic-end-context");
 		evSymbolicEndCtx.lstNodes.push_back(ndParent);
-		this->deployEvent(evSymbolicEndCtx);
+		this->deployEvent(std::move(evSymbolicEndCtx));
+		this->markNodeEnded(ndParent);
 		
 		ndParent = ndParent->parent();
 	      } else {
@@ -256,27 +305,30 @@ namespace semrec {
 	    
 	    Event evUpdateExperimentTime;
 	    if(ndParentLastValid) {
-	      ndParentLastValid->ensureProperty("time-end", strTimeEnd);
+	      this->ensureTimeEnd(ndParentLastValid, dTimeEnd, strTimeEnd);
 	      
 	      evUpdateExperimentTime = defaultEvent("update-absolute-experiment-end-time");
 	      evUpdateExperimentTime.lstNodes.push_back(ndParentLastValid);
-	      this->deployEvent(evUpdateExperimentTime);
+	      evUpdateExperimentTime.strSupplementary = ndParentLastValid->timeEndString();
+	      this->deployEvent(std::move(evUpdateExperimentTime));
 	    }
 
 	    evUpdateExperimentTime = defaultEvent("update-absolute-experiment-end-time");
 	    evUpdateExperimentTime.lstNodes.push_back(ndCurrent);
-	    this->deployEvent(evUpdateExperimentTime);
+	    evUpdateExperimentTime.strSupplementary = ndCurrent->timeEndString();
+	    this->deployEvent(std::move(evUpdateExperimentTime));
 	    
 	    this->setNodeSuccess(ndCurrent, ndCurrent->success());
 	    
 	    Event evSymbolicEndCtx = defaultEvent("symbolic-end-context");
 	    evSymbolicEndCtx.lstNodes.push_back(ndCurrent);
-	    this->deployEvent(evSymbolicEndCtx);
+	    this->deployEvent(std::move(evSymbolicEndCtx));
+	    this->markNodeEnded(ndCurrent);
           } else if(evEvent.cdDesignator->childForKey("_relative_context_id")) {
             // assert: contextID != nID
             int contextID = ((int) evEvent.cdDesignator->floatValue("_relative_context_id"));
 
-            this->info("Received stop node designator for ID" + this->str(nID) + 
+            SEMREC_INFO("Received stop node designator for ID" + this->str(nID) + 
                 " together with relative-context-id " + this->str(contextID));
 
             Node* ndTarget = this->nodeByID(nID);
@@ -294,11 +346,11 @@ namespace semrec {
 	      }
 	    
               // record end-time
-	      std::string strTimeEnd = this->getTimeStampStr();
+	      double dTimeEnd = this->getTimeStampPrecise();
 	      if(evEvent.cdDesignator->childForKey("_time-end")) {
-	        strTimeEnd = this->getTimeStampStr(evEvent.cdDesignator->floatValue("_time-end"));
+	        dTimeEnd = evEvent.cdDesignator->floatValue("_time-end");
 	      }
-	      ndTarget->metaInformation()->setValue(std::string("time-end"), strTimeEnd);
+	      ndTarget->setTimeEnd(dTimeEnd, this->getTimeStampStr(dTimeEnd));
 
               // if the active node was stopped, designate the relative context node as new active node
               if(this->activeNode() == ndTarget)
@@ -307,32 +359,37 @@ namespace semrec {
               Event evUpdateExperimentTime;
               evUpdateExperimentTime = defaultEvent("update-absolute-experiment-end-time");
               evUpdateExperimentTime.lstNodes.push_back(ndTarget);
-              this->deployEvent(evUpdateExperimentTime);
+              evUpdateExperimentTime.strSupplementary = ndTarget->timeEndString();
+              this->deployEvent(std::move(evUpdateExperimentTime));
               
               Event evSymbolicEndCtx = defaultEvent("symbolic-end-context");
               evSymbolicEndCtx.lstNodes.push_back(ndTarget);
-              this->deployEvent(evSymbolicEndCtx);
+              this->deployEvent(std::move(evSymbolicEndCtx));
+              this->markNodeEnded(ndTarget);
             } else 
-              this->warn("Could not find node to with ID " + this->str(nID));
+              SEMREC_WARN("Could not find node to with ID " + this->str(nID));
 	  } else {
-	    std::stringstream sts;
-	    sts << "Received stop node designator for ID " << nID << " while ID " << ndCurrent->id() << " is active.";
-	    this->info(sts.str());
+	    SEMREC_INFO("Received stop node designator for ID " + this->str(nID) + " while ID " + this->str(ndCurrent->id()) + " is active.");
 	    
-	    std::string strTimeEnd = this->getTimeStampStr();
+	    double dTimeEnd = this->getTimeStampPrecise();
+	    std::string strTimeEnd = this->getTimeStampStr(dTimeEnd);
 	    Node* ndEndedPrematurely = NULL;
 	    Node* ndSearchTemp = ndCurrent;
 	    
 	    while(ndSearchTemp) {
+	      // These contexts stay open (and can still change) until
+	      // they are stopped themselves, so they are not marked as
+	      // ended here.
 	      Event evSymbolicEndCtx = defaultEvent("symbolic-end-context");
 	      evSymbolicEndCtx.lstNodes.push_back(ndSearchTemp);
-	      this->deployEvent(evSymbolicEndCtx);
+	      this->deployEvent(std::move(evSymbolicEndCtx));
 	      
-	      ndSearchTemp->ensureProperty("time-end", strTimeEnd);
+	      this->ensureTimeEnd(ndSearchTemp, dTimeEnd, strTimeEnd);
 	      
 	      Event evUpdateExperimentTime = defaultEvent("update-absolute-experiment-end-time");
 	      evUpdateExperimentTime.lstNodes.push_back(ndSearchTemp);
-	      this->deployEvent(evUpdateExperimentTime);
+	      evUpdateExperimentTime.strSupplementary = ndSearchTemp->timeEndString();
+	      this->deployEvent(std::move(evUpdateExperimentTime));
 	      
 	      if(ndSearchTemp->id() == nID) {
 		ndEndedPrematurely = ndSearchTemp;
@@ -344,24 +401,20 @@ namespace semrec {
 	    
 	    if(ndEndedPrematurely) {
 	      // Found the prematurely ended node in this branch
-	      std::stringstream sts;
-	      sts << "Marking node " << nID << " as prematurely ended.";
-	      this->info(sts.str());
+	      SEMREC_INFO("Marking node " + this->str(nID) + " as prematurely ended.");
 	      
 	      ndEndedPrematurely->setPrematurelyEnded(true);
 	    } else {
 	      // Didn't find the prematurely ended node in this branch
-	      std::stringstream sts;
-	      sts << "The apparently prematurely ended node " << nID << " was not found.";
-	      this->warn(sts.str());
+	      SEMREC_WARN("The apparently prematurely ended node " + this->str(nID) + " was not found.");
 	    }
 	  }
 	} else {
-	  std::stringstream sts;
-	  sts << "Received stop node designator for ID " << nID << " while in top-level.";
-	  this->warn(sts.str());
+	  SEMREC_WARN("Received stop node designator for ID " + this->str(nID) + " while in top-level.");
 	}
-      } else if(evEvent.strEventName == "add-image-from-file") {
+      } break;
+	
+      case eventID("add-image-from-file"): {
 	if(evEvent.cdDesignator) {
 	  if(this->activeNode()) {
 	    std::string strFilepath = evEvent.cdDesignator->stringValue("filename");
@@ -374,7 +427,7 @@ namespace semrec {
 	      if(ndSubject) {
 		ndSubject->addImage(strTopic, strFilepath, strTimeImage);
 		
-		this->info("Added image to active node (id " + this->str(ndSubject->id()) + "): '" + strFilepath + "'");
+		SEMREC_INFO("Added image to active node (id " + this->str(ndSubject->id()) + "): '" + strFilepath + "'");
 		
 		Event evSymbolicAddImage = defaultEvent("symbolic-add-image");
 		evSymbolicAddImage.lstNodes.push_back(ndSubject);
@@ -384,7 +437,7 @@ namespace semrec {
 		evSymbolicAddImage.cdDesignator->setValue("filename", strFilepath);
 		evSymbolicAddImage.cdDesignator->setValue("time-capture", strTimeImage);
 		evSymbolicAddImage.nOpenRequestID = evEvent.nOpenRequestID;
-		this->deployEvent(evSymbolicAddImage);
+		this->deployEvent(std::move(evSymbolicAddImage));
 	      } else {
 		this->fail("Cannot add image: Given relative parent node (ID = " + this->str((int)evEvent.cdDesignator->floatValue("_relative_context_id")) + ") does not exist. This is a problem.");
 	      }
@@ -396,7 +449,9 @@ namespace semrec {
 	    this->warn("No node context available. Cannot add image from file while on top-level.");
 	  }
 	}
-      } else if(evEvent.strEventName == "add-failure") {
+      } break;
+	
+      case eventID("add-failure"): {
 	if(evEvent.cdDesignator) {
 	  Node* ndSubject = this->relativeActiveNode(evEvent);
 	  
@@ -412,7 +467,7 @@ namespace semrec {
 	    
 	    m_prLastFailure = std::make_pair(strFailureID, ndSubject);
 	    
-	    this->info("Added failure '" + m_prLastFailure.first + "' to active node (id " + this->str(ndSubject->id()) + "): '" + strCondition.c_str() + "'");
+	    SEMREC_INFO("Added failure '" + m_prLastFailure.first + "' to active node (id " + this->str(ndSubject->id()) + "): '" + strCondition.c_str() + "'");
 	    
 	    Event evSymbAddFailure = defaultEvent("symbolic-add-failure");
 	    evSymbAddFailure.lstNodes.push_back(ndSubject);
@@ -420,12 +475,14 @@ namespace semrec {
 	    evSymbAddFailure.cdDesignator->setType(Designator::DesignatorType::ACTION);
 	    evSymbAddFailure.cdDesignator->setValue("condition", strCondition);
 	    evSymbAddFailure.cdDesignator->setValue("time-fail", strTimeFail);
-	    this->deployEvent(evSymbAddFailure);
+	    this->deployEvent(std::move(evSymbAddFailure));
 	  } else {
 	    this->warn("No node context available. Cannot add failure while on top-level (this can also mean that the targetted relative node ID does not exist).");
 	  }
 	}
-      } else if(evEvent.strEventName == "catch-failure") {
+      } break;
+	
+      case eventID("catch-failure"): {
 	if(evEvent.cdDesignator) {
 	  Node* ndSubject = this->relativeActiveNode(evEvent);
 	  
@@ -444,12 +501,12 @@ namespace semrec {
 		  // Associate this failure with its catching node
 		  m_mapFailureCatchers[m_prLastFailure.first] = ndRelative;
 		  
-		  this->info("Context (ID = " + strID + ") caught failure '" + m_prLastFailure.first + "'");
+		  SEMREC_INFO("Context (ID = " + strID + ") caught failure '" + m_prLastFailure.first + "'");
 		} else {
 		  this->fail("Relative with ID " + strID + " not found up the chain while catching failure.");
 		}
 	      } else {
-		this->warn("Invalid context ID when catching failure: '" + strID + "'.");
+		SEMREC_WARN("Invalid context ID when catching failure: '" + strID + "'.");
 	      }
 	    } else {
 	      this->warn("Tried to catch failure without one being present.");
@@ -458,7 +515,9 @@ namespace semrec {
 	    this->fail("Cannot catch failures outside of context.");
 	  }
 	}
-      } else if(evEvent.strEventName == "rethrow-failure") {
+      } break;
+	
+      case eventID("rethrow-failure"): {
 	if(evEvent.cdDesignator) {
 	  if(m_prLastFailure.first != "") {
 	    if(m_mapFailureCatchers[m_prLastFailure.first]) {
@@ -466,15 +525,17 @@ namespace semrec {
 	      m_mapFailureCatchers[m_prLastFailure.first] = NULL;
 	      
 	      std::string strID = evEvent.cdDesignator->stringValue("context-id");
-	      this->info("Context (ID = " + strID + ") rethrew failure '" + m_prLastFailure.first + "'");
+	      SEMREC_INFO("Context (ID = " + strID + ") rethrew failure '" + m_prLastFailure.first + "'");
 	    } else {
-	      this->warn("Apparently caught failure '" + m_prLastFailure.first + "' is not in failure catchers map.");
+	      SEMREC_WARN("Apparently caught failure '" + m_prLastFailure.first + "' is not in failure catchers map.");
 	    }
 	  } else {
 	    this->warn("Tried to rethrow failure without active failure. This is probably not what you wanted.");
 	  }
 	}
-      } else if(evEvent.strEventName == "add-designator") {
+      } break;
+	
+      case eventID("add-designator"): {
 	if(evEvent.cdDesignator) {
 	  Node* ndSubject = this->relativeActiveNode(evEvent);
 	  
@@ -491,7 +552,9 @@ namespace semrec {
 	    this->warn("No node context available. Cannot add designator while on top-level.");
 	  }
 	}
-      } else if(evEvent.strEventName == "equate-designators") {
+      } break;
+	
+      case eventID("equate-designators"): {
 	if(evEvent.cdDesignator) {
 	  std::string strMemAddrChild = evEvent.cdDesignator->stringValue("memory-address-child");
 	  std::string strMemAddrParent = evEvent.cdDesignator->stringValue("memory-address-parent");
@@ -524,7 +587,7 @@ namespace semrec {
 	      std::string strUniqueIDParent = this->getDesignatorID(strMemAddrParent);
 	      std::string strUniqueIDChild = this->getDesignatorID(strMemAddrChild);
 	      
-	      this->info("Equated designators " + strUniqueIDChild + " (successor) and " + strUniqueIDParent + " (parent).");
+	      SEMREC_INFO("Equated designators " + strUniqueIDChild + " (successor) and " + strUniqueIDParent + " (parent).");
 	      
 	      Event evEquateDesigs = defaultEvent("symbolic-equate-designators");
 	      evEquateDesigs.cdDesignator = new Designator();
@@ -537,7 +600,9 @@ namespace semrec {
 	    }
 	  }
 	}
-      } else if(evEvent.strEventName == "add-object") {
+      } break;
+	
+      case eventID("add-object"): {
 	if(evEvent.cdDesignator) {
 	  KeyValuePair* ckvpDesc = evEvent.cdDesignator->childForKey("description");
 	  
@@ -575,7 +640,7 @@ namespace semrec {
 		evAddedDesignator.lstNodes.push_back(ndSubject);
 		evAddedDesignator.strAnnotation = evEvent.cdDesignator->stringValue("annotation");
 		
-		this->deployEvent(evAddedDesignator);
+		this->deployEvent(std::move(evAddedDesignator));
 	      }
 	      
 	      ckvpDesc->setValue("__id", strUniqueID);
@@ -597,7 +662,7 @@ namespace semrec {
 	      }
 	      
 	      ndSubject->addObject(ckvpDesc->children());
-	      this->info("Added object (" + strUniqueID + ") to active node (id " + this->str(ndSubject->id()) + ").");
+	      SEMREC_INFO("Added object (" + strUniqueID + ") to active node (id " + this->str(ndSubject->id()) + ").");
 	      
 	      // Signal symbolic addition of object
 	      Event evSymAddObj = defaultEvent("symbolic-add-object");
@@ -630,7 +695,9 @@ namespace semrec {
 	    }
 	  }
 	}
-      } else if(evEvent.strEventName == "add-human") {
+      } break;
+	
+      case eventID("add-human"): {
 	if(evEvent.cdDesignator) {
 	  KeyValuePair* ckvpDesc = evEvent.cdDesignator->childForKey("description");
 	  
@@ -648,7 +715,7 @@ namespace semrec {
 	      delete desigCurrent;
 	      
 	      if(!bDesigExists) { // Human does not yet exist. Add it symbolically.
-		this->info("Adding non-existant human-designator to context with ID " + this->str(ndSubject->id()));
+		SEMREC_INFO("Adding non-existant human-designator to context with ID " + this->str(ndSubject->id()));
 		
 		KeyValuePair* ckvpDesc = evEvent.cdDesignator->childForKey("description");
 		std::list<KeyValuePair*> lstDescription = ckvpDesc->children();
@@ -668,7 +735,7 @@ namespace semrec {
 		evAddedDesignator.lstNodes.push_back(ndSubject);
 		evAddedDesignator.strAnnotation = evEvent.cdDesignator->stringValue("annotation");
 		
-		this->deployEvent(evAddedDesignator);
+		this->deployEvent(std::move(evAddedDesignator));
 	      }
 	      
 	      ckvpDesc->setValue("__id", strUniqueID);
@@ -694,44 +761,114 @@ namespace semrec {
 	      }
       
 	      ndSubject->addHuman(ckvpDesc->children());
-	      this->info("Added human (" + strUniqueID + ") to node (id " + this->str(ndSubject->id()) + ").");
+	      SEMREC_INFO("Added human (" + strUniqueID + ") to node (id " + this->str(ndSubject->id()) + ").");
 	    } else {
 	      this->warn("No node context available. Cannot add object while on top-level.");
 	    }
 	  }
 	}
-      } else if(evEvent.strEventName == "start-new-experiment") {
+      } break;
+	
+      case eventID("start-new-experiment"): {
 	this->info("Clearing symbolic log for new experiment.");
 	
 	m_mapNodeIDs.clear();
-	
-	for(Node* ndNode : m_lstNodes) {
-	  delete ndNode;
-	}
+	m_setEndedNodes.clear();
+	m_setFinalizedNodes.clear();
+	m_mapFinalizedSubnodes.clear();
 	
 	m_lstNodes.clear();
+	m_lstNodesWithoutTimeEnd.clear();
+	this->renewNodeArena();
 	m_lstRootNodes.clear();
 	m_ndActive = NULL;
 	
-	m_lstDesignatorIDs.clear();
-	m_lstDesignatorEquations.clear();
-	m_lstDesignatorEquationTimes.clear();
+	m_drDesignators.clear();
 	
 	m_prLastFailure = std::make_pair("", (Node*)NULL);
 	
-	srand(time(NULL));
+	m_uigDesignatorIDs.reset();
 	
 	this->info("Ready for new experiment.");
-      } else {
-	this->warn("Unknown event name: '" + evEvent.strEventName + "'");
+      } break;
+	
+      default: {
+	SEMREC_WARN("Unknown event name: '" + evEvent.strEventName + "'");
+      } break;
+      }
+    }
+    
+    void PLUGIN_CLASS::ensureTimeEnd(Node* ndRoot, double dTimeEnd, std::string strTimeEnd) {
+      // Only nodes that never got an end time need one, so instead of
+      // walking ndRoot's subtree, go through those (usually just the
+      // currently open contexts) and set it on the ones below ndRoot.
+      std::list<Node*>::iterator itNode = m_lstNodesWithoutTimeEnd.begin();
+      
+      while(itNode != m_lstNodesWithoutTimeEnd.end()) {
+	Node* ndCurrent = *itNode;
+	
+	if(ndCurrent->hasTimeEnd()) {
+	  // Ended explicitly in the meantime
+	  itNode = m_lstNodesWithoutTimeEnd.erase(itNode);
+	} else if(ndCurrent == ndRoot || ndCurrent->hasAncestor(ndRoot)) {
+	  ndCurrent->setTimeEnd(dTimeEnd, strTimeEnd);
+	  itNode = m_lstNodesWithoutTimeEnd.erase(itNode);
+	} else {
+	  itNode++;
+	}
+      }
+    }
+    
+    void PLUGIN_CLASS::markNodeEnded(Node* ndEnded) {
+      m_setEndedNodes.insert(ndEnded);
+      this->finalizeCompletedNodes(ndEnded);
+    }
+    
+    void PLUGIN_CLASS::renewNodeArena() {
+      // A `start-new-experiment' can be dispatched before events
+      // this plugin deployed earlier. Those keep the old nodes alive
+      // through m_ptdFinalizeData, and receivers tell by the retired
+      // arena that they are outdated.
+      if(m_naNodes) {
+	m_naNodes->retire();
+      }
+      
+      m_naNodes = std::make_shared<NodeArena>();
+      
+      std::shared_ptr<PlanTreeData> ptdFinalizeData = std::make_shared<PlanTreeData>();
+      ptdFinalizeData->naNodes = m_naNodes;
+      m_ptdFinalizeData = ptdFinalizeData;
+    }
+    
+    void PLUGIN_CLASS::finalizeCompletedNodes(Node* ndFrom) {
+      Node* ndCurrent = ndFrom;
+      
+      while(ndCurrent &&
+	    m_setFinalizedNodes.find(ndCurrent) == m_setFinalizedNodes.end() &&
+	    m_setEndedNodes.find(ndCurrent) != m_setEndedNodes.end() &&
+	    m_mapFinalizedSubnodes[ndCurrent] == ndCurrent->subnodeCount() &&
+	    !(m_ndActive && (m_ndActive == ndCurrent || m_ndActive->hasAncestor(ndCurrent)))) {
+	m_setFinalizedNodes.insert(ndCurrent);
+	
+	Event evSymbolicFinalizeCtx = defaultEvent("symbolic-finalize-context");
+	evSymbolicFinalizeCtx.lstNodes.push_back(ndCurrent);
+	evSymbolicFinalizeCtx.ptdPlanTree = m_ptdFinalizeData;
+	this->deployEvent(std::move(evSymbolicFinalizeCtx));
+	
+	ndCurrent = ndCurrent->parent();
+	
+	if(ndCurrent) {
+	  m_mapFinalizedSubnodes[ndCurrent]++;
+	}
       }
     }
     
     Node* PLUGIN_CLASS::addNode(std::string strName, int nContextID, Node* ndParent) {
-      Node* ndNew = new Node(strName);
+      Node* ndNew = m_naNodes->createNode(strName);
       ndNew->setID(nContextID);
       
       m_mapNodeIDs[nContextID] = ndNew;
+      m_lstNodesWithoutTimeEnd.push_back(ndNew);
       
       if(ndParent == NULL) {
 	// No parent mode was manually set. Use the currently active
@@ -741,23 +878,27 @@ namespace semrec {
       
       bool bSetAsActive = (ndParent == m_ndActive);
       
+      if(ndParent && m_setFinalizedNodes.find(ndParent) != m_setFinalizedNodes.end()) {
+	SEMREC_WARN("Adding context ID " + this->str(nContextID) + " below the already finalized context ID " + this->str(ndParent->id()) + ", incremental exports will not contain it.");
+      }
+      
       if(ndParent == NULL) {
 	// Add a new top-level node
 	m_lstNodes.push_back(ndNew);
 	
-	this->info("Adding new top-level context with ID " + this->str(nContextID));
+	SEMREC_INFO("Adding new top-level context with ID " + this->str(nContextID));
       } else {
 	// Add it as a subnode to the current contextual node
 	ndParent->addSubnode(ndNew);
 	
-	this->info("Adding new sub context with ID " + this->str(nContextID));
+	SEMREC_INFO("Adding new sub context with ID " + this->str(nContextID));
       }
       
       if(bSetAsActive) {
 	this->setNodeAsActive(ndNew);
-	this->info("The new context's name is '" + strName + "' (now active, ID " + this->str(nContextID) + ")");
+	SEMREC_INFO("The new context's name is '" + strName + "' (now active, ID " + this->str(nContextID) + ")");
       } else {
-	this->info("The new context's name is '" + strName + "'");
+	SEMREC_INFO("The new context's name is '" + strName + "'");
       }
       
       return ndNew;
@@ -765,6 +906,7 @@ namespace semrec {
     
     void PLUGIN_CLASS::setNodeAsActive(Node* ndActive) {
       bool bSame = false;
+      Node* ndPreviouslyActive = m_ndActive;
       
       if(!m_ndActive && ndActive) {
 	m_lstRootNodes.push_back(ndActive);
@@ -778,13 +920,13 @@ namespace semrec {
       
       if(m_ndActive) {
 	if(!bSame) {
-	  this->info("Setting context ID " + this->str(m_ndActive->id()) + " as active context");	  
+	  SEMREC_INFO("Setting context ID " + this->str(m_ndActive->id()) + " as active context");
 	}
 	
 	// This activates the given node
 	Event evActiveNode = defaultEvent("symbolic-node-active");
 	evActiveNode.lstNodes.push_back(m_ndActive);
-	this->deployEvent(evActiveNode);
+	this->deployEvent(std::move(evActiveNode));
       } else {
 	this->info("Removed active context, returning to top-level");
 	
@@ -792,6 +934,12 @@ namespace semrec {
 	Event evActiveNode = defaultEvent("symbolic-node-active");
 	this->deployEvent(evActiveNode);
       }
+      
+      if(ndPreviouslyActive && ndPreviouslyActive != m_ndActive) {
+	// Ended contexts that were kept open by the active context
+	// might be complete now
+	this->finalizeCompletedNodes(ndPreviouslyActive);
+      }
     }
     
     Node* PLUGIN_CLASS::activeNode() {
@@ -799,16 +947,7 @@ namespace semrec {
     }
     
     std::string PLUGIN_CLASS::getDesignatorID(std::string strMemoryAddress) {
-      std::string strID = "";
-      
-      for(std::pair<std::string, std::string> prPair : m_lstDesignatorIDs) {
-	if(prPair.first == strMemoryAddress) {
-	  strID = prPair.second;
-	  break;
-	}
-      }
-      
-      return strID;
+      return m_drDesignators.idForMemoryAddress(strMemoryAddress);
     }
     
     std::string PLUGIN_CLASS::getDesignatorIDType(Designator* desigCurrent) {
@@ -844,41 +983,20 @@ namespace semrec {
       std::string strID = this->getDesignatorID(strMemoryAddress);
       
       if(strID == "") {
-	strID = this->generateRandomIdentifier(this->getDesignatorIDType(desigCurrent) + "_", 14);
-	m_lstDesignatorIDs.push_back(std::make_pair(strMemoryAddress, strID));
+	strID = m_uigDesignatorIDs.uniqueID(this->getDesignatorIDType(desigCurrent) + "_", 14);
+	m_drDesignators.registerDesignator(strMemoryAddress, strID);
       }
       
       return strID;
     }
     
-    std::string PLUGIN_CLASS::generateRandomIdentifier(std::string strPrefix, unsigned int unLength) {
-      std::stringstream sts;
-      sts << strPrefix;
-      
-      for(unsigned int unI = 0; unI < unLength; unI++) {
-	int nRandom;
-	do {
-	  nRandom = rand() % 122 + 48;
-	} while(nRandom < 48 ||
-		(nRandom > 57 && nRandom < 65) ||
-		(nRandom > 90 && nRandom < 97) ||
-		nRandom > 122);
-	
-	char cRandom = (char)nRandom;
-	sts << cRandom;
-      }
-      
-      return sts.str();
-    }
-    
     std::string PLUGIN_CLASS::equateDesignators(std::string strMAChild, Designator* desigChild, std::string strMAParent, Designator* desigParent) {
       std::string strIDChild = this->getUniqueDesignatorID(strMAChild, desigChild);
       std::string strIDParent = this->getUniqueDesignatorID(strMAParent, desigParent);
       
       std::string strTimeStart = this->getTimeStampStr();
       
-      m_lstDesignatorEquations.push_back(std::make_pair(strIDParent, strIDChild));
-      m_lstDesignatorEquationTimes.push_back(std::make_pair(strIDChild, strTimeStart));
+      m_drDesignators.addEquation(strIDParent, strIDChild, strTimeStart);
       
       return strTimeStart;
     }
@@ -900,7 +1018,7 @@ namespace semrec {
       if(bAdd) {
 	ndRelative->addDesignator(strType, desigCurrent->children(), strUniqueID, strAnnotation);
 	
-	this->info("Added '" + strType + "' designator (addr=" + strMemoryAddress + ") to context (ID " + this->str(ndRelative->id()) + "): '" + strUniqueID + "', annotation: '" + strAnnotation + "'");
+	SEMREC_INFO("Added '" + strType + "' designator (addr=" + strMemoryAddress + ") to context (ID " + this->str(ndRelative->id()) + "): '" + strUniqueID + "', annotation: '" + strAnnotation + "'");
       }
       
       desigCurrent->setValue("_id", strUniqueID);
@@ -929,7 +1047,7 @@ namespace semrec {
       evAddedDesignator.strAnnotation = strAnnotation;
       evAddedDesignator.lstNodes.push_back(ndRelative);
       
-      this->deployEvent(evAddedDesignator);
+      this->deployEvent(std::move(evAddedDesignator));
       
       bReturn = true;
       
@@ -1020,7 +1138,7 @@ namespace semrec {
       
       Event evSetSuccess = defaultEvent("symbolic-set-node-success");
       evSetSuccess.lstNodes.push_back(ndNode);
-      this->deployEvent(evSetSuccess);
+      this->deployEvent(std::move(evSetSuccess));
     }
   }
   